@@ -7,12 +7,28 @@ Project layout
 ──────────────
 app.py               ← run with: streamlit run app.py
 logic/
-  graph.py           ← DIMACS parser
+  graph.py           ← DIMACS / binary .csr parsers
   solver.py          ← ctypes wrapper; auto-compiles C on first run
+  cache.py           ← on-disk best-result cache keyed by graph hash
+  bench.py           ← headless benchmark suite + regression checks
   coloring.h         ← shared C types, BBState, inline helpers
   heuristics.c/h     ← greedy clique + DSATUR (C)
+  clique.c/h         ← exact bit-parallel maximum clique (C)
+  frac.c/h           ← fractional chromatic LB by column generation (C)
+  reduce.c/h         ← kernelization + engine-independent solve front end (C)
+  blocks.c/h         ← biconnected blocks, block-parallel solve (C)
+  relabel.c/h        ← locality vertex orders, relabeled CSR (C)
   bb_sewell.c        ← Sewell (1996) B&B (C)
   bb_furini.c        ← Furini (2017) B&B with reduced-graph LB (C)
+  backjump.c/h       ← conflict-directed backjumping + nogoods (C)
+  parallel.c/h       ← work-stealing driver for *_solve_parallel (C)
+  portfolio.c        ← cooperative Sewell/Furini portfolio (C)
+  progress.c         ← progress ring reader side (C)
+  checkpoint.c/h     ← save / resume stopped B&B runs (C)
+  loader.c           ← native DIMACS → CSR loader (C)
+  batch.c/h          ← thread pool over many small graphs (C)
+  dynamic.c/h        ← mutable graph with local recolouring (C)
+  bench.c            ← headless one-run benchmark driver (C)
 ui/
   theme.py           ← global CSS
   components.py      ← reusable HTML blocks
@@ -56,7 +72,9 @@ for _k, _v in [
     ("graph_pos",       None),
     ("res_sewell",      None),
     ("res_furini",      None),
+    ("res_portfolio",   None),
     ("temps_max",       120),
+    ("use_cache",       False),
 ]:
     st.session_state.setdefault(_k, _v)
 
@@ -68,6 +86,12 @@ with st.sidebar:
         min_value=10, max_value=300,
         value=st.session_state.temps_max, step=10,
     )
+    st.session_state.use_cache = st.checkbox(
+        "Warm-start from result cache",
+        value=st.session_state.use_cache,
+        help="Seed Sewell / Furini with the best colouring and proven LB "
+             "cached for this graph, and cache the new result.",
+    )
     st.markdown(divider(), unsafe_allow_html=True)
     st.markdown("""
 <div style="font-family:'IBM Plex Mono',monospace;font-size:.78rem;
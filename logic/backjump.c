@@ -0,0 +1,138 @@
+/*
+ * backjump.c
+ * ──────────
+ * Conflict sets, backjump targets and the nogood table (see backjump.h).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "backjump.h"
+
+BJState* bj_new(int n, int ncolors, int mode) {
+    if (!(mode & (BB_BACKJUMP | BB_NOGOODS)) || n <= 0 || n > BJ_MAX_N) return NULL;
+    BJState* bj = (BJState*)calloc(1, sizeof(BJState));
+    if (!bj) return NULL;
+    bj->mode   = mode;
+    bj->dw     = (n + 63) >> 6;
+    bj->conf   = (uint64_t*)malloc((size_t)(n + 1) * bj->dw * sizeof(uint64_t));
+    bj->chrono = (uint8_t*)malloc(n + 1);
+    bj->depth  = (int*)malloc(n * sizeof(int));
+    bj->first  = (int*)malloc((ncolors > 0 ? ncolors : 1) * sizeof(int));
+    int ok = bj->conf && bj->chrono && bj->depth && bj->first;
+    if (ok && (mode & BB_NOGOODS)) {
+        bj->ng      = (Nogood*)malloc((size_t)NOGOOD_SETS * NOGOOD_WAYS * sizeof(Nogood));
+        bj->ng_next = (uint8_t*)calloc(NOGOOD_SETS, 1);
+        ok = bj->ng && bj->ng_next;
+        for (int i = 0; ok && i < NOGOOD_SETS * NOGOOD_WAYS; i++) bj->ng[i].v = -1;
+    }
+    if (!ok) { bj_free(bj); return NULL; }
+    for (int v = 0; v < n; v++) bj->depth[v] = -1;
+    for (int c = 0; c < ncolors; c++) bj->first[c] = INT_MAX;
+    return bj;
+}
+
+void bj_free(BJState* bj) {
+    if (!bj) return;
+    free(bj->conf); free(bj->chrono); free(bj->depth); free(bj->first);
+    free(bj->ng); free(bj->ng_next);
+    free(bj);
+}
+
+void bj_report(const BJState* bj, const BBStart* x) {
+    if (!bj) return;
+    if (x->out_jumps)       __atomic_fetch_add(x->out_jumps, bj->jumps, __ATOMIC_RELAXED);
+    if (x->out_nogood_cuts) __atomic_fetch_add(x->out_nogood_cuts, bj->ng_cuts, __ATOMIC_RELAXED);
+}
+
+static inline Nogood* ng_set(const BJState* bj, int v, int c) {
+    uint32_t h = (uint32_t)v * 2654435761u ^ (uint32_t)c * 2246822519u;
+    return bj->ng + (size_t)((h ^ (h >> 15)) & (NOGOOD_SETS - 1)) * NOGOOD_WAYS;
+}
+
+static inline void row_set(uint64_t* row, int d) { row[d >> 6] |= 1ULL << (d & 63); }
+
+/* Deepest depth in a conflict row, -1 if empty */
+static int row_top(const uint64_t* row, int dw) {
+    for (int w = dw - 1; w >= 0; w--)
+        if (row[w]) return (w << 6) + 63 - __builtin_clzll(row[w]);
+    return -1;
+}
+
+/* ── The assignments of row as a nogood keyed by depth h ───────────── */
+static void ng_record(BJState* bj, const BBFrame* st, const uint64_t* row, int h) {
+    int len = 0;
+    for (int w = 0; w < bj->dw; w++) len += CS_COUNT(row[w]);
+    if (len > NOGOOD_LEN) return;
+
+    Nogood* set = ng_set(bj, st[h].v, st[h].c);
+    size_t  si  = (size_t)(set - bj->ng) / NOGOOD_WAYS;
+    Nogood* e   = set + bj->ng_next[si]++ % NOGOOD_WAYS;
+    e->v = st[h].v; e->c = st[h].c; e->len = 0;
+    for (int w = 0; w < bj->dw; w++)
+        for (uint64_t b = row[w]; b; b &= b - 1) {
+            int d = (w << 6) + CS_LOWEST(b);
+            if (d == h) continue;
+            e->u[e->len] = st[d].v; e->uc[e->len] = st[d].c; e->len++;
+        }
+}
+
+int bj_refuted(BBState* s, BJState* bj, int i, int v, int c) {
+    if (!bj->ng) return 0;
+    const Nogood* e = ng_set(bj, v, c);
+    for (int w = 0; w < NOGOOD_WAYS; w++, e++) {
+        if (e->v != v || e->c != c) continue;
+        int j = 0;
+        while (j < e->len && s->vert[e->u[j]].color == e->uc[j]) j++;
+        if (j < e->len) continue;
+
+        uint64_t* row = bj->conf + (size_t)i * bj->dw;
+        for (j = 0; j < e->len; j++) row_set(row, bj->depth[e->u[j]]);
+        bj->ng_cuts++;
+        s->branches_cut++;
+        return 1;
+    }
+    return 0;
+}
+
+int bj_resume(BBState* s, BJState* bj, int i) {
+    const BBFrame* st  = s->stack;
+    const BBFrame* f   = &st[i];
+    uint64_t*      row = bj->conf + (size_t)i * bj->dw;
+
+    /* A bound or leaf below, or a UB that fell under the colours in use */
+    if (bj->chrono[i] || f->k >= s->UB) {
+        if (i > 0) bj->chrono[i - 1] = 1;
+        return i - 1;
+    }
+
+    /* Colours taken by neighbours: the shallowest holder of each. Colours
+       ≥ lim need no reason (≥ UB − 1, or renamings of colour k) */
+    int lim = f->c_limit < s->UB - 1 ? f->c_limit : s->UB - 1;
+    int v = f->v;
+    for (int j = s->start[v]; j < s->start[v] + s->deg[v]; j++) {
+        int u = s->adj[j], cu = s->vert[u].color;
+        if (cu < 0 || cu >= lim) continue;
+        int d = bj->depth[u];
+        if (d >= 0 && d < bj->first[cu]) bj->first[cu] = d;
+    }
+    for (int c = 0; c < lim; c++)
+        if (bj->first[c] != INT_MAX) { row_set(row, bj->first[c]); bj->first[c] = INT_MAX; }
+
+    int h = row_top(row, bj->dw);
+    if (bj->ng && h >= 0) ng_record(bj, st, row, h);
+    if (!(bj->mode & BB_BACKJUMP) && i > 0) h = i - 1;
+    if (h < 0) {
+        bj->jumps += i;
+        s->branches_cut += i;
+        return -1;
+    }
+
+    /* Frame h inherits the reasons, less its own assignment */
+    uint64_t* dst = bj->conf + (size_t)h * bj->dw;
+    for (int w = 0; w < bj->dw; w++) dst[w] |= row[w];
+    dst[h >> 6] &= ~(1ULL << (h & 63));
+    bj->jumps += i - 1 - h;
+    s->branches_cut += i - 1 - h;
+    return h;
+}
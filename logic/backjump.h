@@ -0,0 +1,113 @@
+#pragma once
+#ifndef BACKJUMP_H
+#define BACKJUMP_H
+
+/*
+ * backjump.h
+ * ──────────
+ * Conflict-directed backjumping (Prosser, 1993) and nogood recording
+ * for the DSATUR B&B of both engines.
+ *
+ * Frame i of the DFS path (vertex v_i, coloured at depth i) collects a
+ * conflict set: the depths whose colours its dead ends depend on.
+ *   colour c ∈ cset(v_i)   the shallowest neighbour of v_i holding c
+ *   child v_i = c failed   the child's conflict set, less depth i
+ *   new colours > k        the reason of colour k (renaming k ↔ c
+ *                          fixes every assignment above v_i)
+ *   colours ≥ UB − 1       none: no colouring below UB uses them
+ * A node closed by a bound or a leaf depends on the whole path, which
+ * makes its frame chronological. When v_i runs out of colours, the
+ * search resumes at the deepest depth h of the set, skipping frames
+ * h+1..i-1: none of their remaining branches changes an assignment the
+ * dead end depends on. An empty set means no colouring below UB exists.
+ *
+ * The assignments of a non-chronological set form a nogood: together
+ * they have no extension below UB (ever, since UB only falls). Short
+ * ones go into a bounded hash table keyed by their deepest assignment;
+ * a later branch making that assignment while the others hold is cut
+ * at once, with the others' depths as its reason.
+ *
+ * Sequential runs only (parallel workers start from task prefixes the
+ * sets know nothing about); skipped above BJ_MAX_N vertices.
+ */
+
+#include "coloring.h"
+
+/* ── Modes (BBStart.backjump), OR-ed ───────────────────────────────── */
+#define BB_BACKJUMP   1     /* jump to the culprit of a dead end       */
+#define BB_NOGOODS    2     /* record dead ends, cut their repeats     */
+
+/* ── Largest graph the per-frame conflict rows are kept for ────────── */
+#define BJ_MAX_N      4096
+
+/* ── Nogood table: NOGOOD_SETS × NOGOOD_WAYS slots, round-robin ────── */
+#define NOGOOD_LEN    8     /* assignments per nogood, key included    */
+#define NOGOOD_SETS   2048  /* power of two                            */
+#define NOGOOD_WAYS   4
+
+typedef struct {
+    int v, c;                   /* key: the deepest assignment          */
+    int len;                    /* other assignments: u[i] = uc[i]      */
+    int u[NOGOOD_LEN - 1];
+    int uc[NOGOOD_LEN - 1];
+} Nogood;
+
+typedef struct BJState {
+    int       mode;
+    int       dw;               /* words per conflict row = ⌈n/64⌉      */
+    uint64_t* conf;             /* conf[i*dw ..]: depths < i frame i
+                                   depends on                          */
+    uint8_t*  chrono;           /* frame i depends on its whole path    */
+    int*      depth;            /* frame that coloured v (stale once v
+                                   is uncoloured), -1 = none            */
+    int*      first;            /* scratch: shallowest depth per colour */
+    Nogood*   ng;               /* NULL unless BB_NOGOODS               */
+    uint8_t*  ng_next;          /* slot replaced next, per set          */
+    long      jumps;            /* frames skipped by backjumps          */
+    long      ng_cuts;          /* branches cut by a recorded nogood    */
+} BJState;
+
+/* ── State for a search over n vertices with colours < ncolors ────────
+ * NULL when mode is 0, n > BJ_MAX_N or out of memory (the search then
+ * backtracks chronologically).
+ * ─────────────────────────────────────────────────────────────────── */
+BJState* bj_new(int n, int ncolors, int mode);
+void     bj_free(BJState* bj);
+
+/* ── End of solve(): counters into x->out_jumps / x->out_nogood_cuts
+ * (added atomically: block solves run side by side)
+ * ─────────────────────────────────────────────────────────────────── */
+void bj_report(const BJState* bj, const BBStart* x);
+
+/* ── Path hooks of explore() ───────────────────────────────────────── */
+
+/* Frame i pushed for vertex v */
+static inline void bj_push(BJState* bj, int i, int v) {
+    memset(bj->conf + (size_t)i * bj->dw, 0, bj->dw * sizeof(uint64_t));
+    bj->chrono[i] = 0;
+    bj->depth[v]  = i;
+}
+
+/* The child of frame i was closed by a bound or a leaf */
+static inline void bj_chrono(BJState* bj, int i) { bj->chrono[i] = 1; }
+
+/* Frames 0..sp-1 replayed from a stopped search: reasons unknown */
+static inline void bj_replayed(BJState* bj, const BBFrame* st, int sp) {
+    for (int i = 0; i < sp; i++) { bj->chrono[i] = 1; bj->depth[st[i].v] = i; }
+}
+
+/* ── Nogood cut: does v = c complete a recorded nogood? ────────────────
+ * If so the other assignments' depths join frame i's conflict set and
+ * the branch is counted as a cut. Frame i's vertex is v.
+ * ─────────────────────────────────────────────────────────────────── */
+int bj_refuted(BBState* s, BJState* bj, int i, int v, int c);
+
+/* ── Frame i (already uncoloured) ran out of colours ───────────────────
+ * Returns the frame to resume: i − 1 when chronological or without
+ * BB_BACKJUMP, the deepest culprit otherwise, -1 when no colouring
+ * below UB exists. The caller uncolours frames i−1 down to the result
+ * + 1; those skipped count in s->branches_cut.
+ * ─────────────────────────────────────────────────────────────────── */
+int bj_resume(BBState* s, BJState* bj, int i);
+
+#endif
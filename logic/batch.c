@@ -0,0 +1,133 @@
+/*
+ * batch.c
+ * ───────
+ * Thread pool over a packed array of graphs (see batch.h).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "parallel.h"
+#include "batch.h"
+
+#define BATCH_POOL_MAX 64
+
+/* ── Engine entry points (bb_sewell.c, bb_furini.c) ───────────────── */
+#define SOLVE_ARGS int n, int* adj, int* start, int* deg,                 \
+                   int temps_max, ProgressRing* progress,                 \
+                   const int* cancel,                                     \
+                   int* out_K, int* out_coloring,                         \
+                   int* out_LB, int* out_UB_init,                         \
+                   int* out_optimal, long* out_nodes, long* out_cuts,     \
+                   double* out_time, int* out_timeout,                    \
+                   int* out_cancelled, int* out_backend
+
+EXPORT int sewell_solve(SOLVE_ARGS);
+EXPORT int furini_solve(SOLVE_ARGS);
+
+/* loader.c */
+EXPORT int csr_check(int n, long entries, const int* adj,
+                     const int* start, const int* deg);
+
+typedef int (*EngineFn)(SOLVE_ARGS);
+
+typedef struct {
+    long cost;          /* expected work: n + entries                   */
+    int  g;
+} BatchJob;
+
+typedef struct {
+    EngineFn      engine;
+    int*          buf;
+    const long*   rec;      /* record offset of graph g in buf          */
+    const long*   col;      /* offset of its colouring in out_colorings */
+    const BatchJob* jobs;   /* largest first                            */
+    int           n_graphs;
+    int           next;     /* atomic: next job to take                 */
+    int           err;      /* atomic: an engine returned BB_ERR_COLORS */
+    int           temps_max;
+    const int*    cancel;   /* caller's token, or NULL                  */
+    BatchResult*  out;
+    int*          out_colorings;
+} Batch;
+
+static int cmp_job_desc(const void* a, const void* b) {
+    const BatchJob* x = (const BatchJob*)a;
+    const BatchJob* y = (const BatchJob*)b;
+    if (x->cost != y->cost) return x->cost < y->cost ? 1 : -1;
+    return x->g - y->g;
+}
+
+static BB_THREAD_RET batch_main(void* arg) {
+    Batch* b = (Batch*)arg;
+    for (;;) {
+        int i = __atomic_fetch_add(&b->next, 1, __ATOMIC_RELAXED);
+        if (i >= b->n_graphs) break;
+        int g = b->jobs[i].g;
+        int* r = b->buf + b->rec[g];
+        int  n = r[0];
+        BatchResult* o = &b->out[g];
+
+        /* Cancelled before it started: heuristic colouring only */
+        int cancelled = bb_cancelled(b->cancel);
+        int st = b->engine(n, r + 2 + 2 * n, r + 2, r + 2 + n,
+                           cancelled ? 0 : b->temps_max, NULL, b->cancel,
+                           &o->K, b->out_colorings + b->col[g], &o->LB, &o->UB_init,
+                           &o->optimal, &o->nodes, &o->cuts, &o->time,
+                           &o->timeout, &o->cancelled, &o->backend);
+        if (st < 0) __atomic_store_n(&b->err, 1, __ATOMIC_RELAXED);
+        if (cancelled) { o->timeout = o->cancelled = 1; o->optimal = 0; }
+    }
+    BB_THREAD_RETURN;
+}
+
+EXPORT int batch_solve(int algo, int* buf, long buf_len, int n_graphs,
+                       int temps_max, int n_threads, const int* cancel,
+                       BatchResult* out, int* out_colorings) {
+    EngineFn engine = algo == BATCH_SEWELL ? sewell_solve
+                    : algo == BATCH_FURINI ? furini_solve : NULL;
+    if (!engine || n_graphs < 0) return 0;
+    if (n_graphs == 0) return 1;
+
+    long*     rec  = (long*)malloc(n_graphs * sizeof(long));
+    long*     col  = (long*)malloc(n_graphs * sizeof(long));
+    BatchJob* jobs = (BatchJob*)malloc(n_graphs * sizeof(BatchJob));
+    int ok = rec && col && jobs;
+
+    /* Walk and check the records */
+    long pos = 0, cpos = 0;
+    for (int g = 0; g < n_graphs && ok; g++) {
+        ok = pos + 2 <= buf_len;
+        if (!ok) break;
+        long n = buf[pos], entries = buf[pos + 1];
+        ok = n >= 0 && entries >= 0 && pos + 2 + 2 * n + entries <= buf_len;
+        const int* r = buf + pos;
+        ok = ok && csr_check((int)n, entries, r + 2 + 2 * n, r + 2, r + 2 + n);
+        if (!ok) break;
+        rec[g] = pos; col[g] = cpos;
+        jobs[g].cost = n + entries; jobs[g].g = g;
+        pos  += 2 + 2 * n + entries;
+        cpos += n;
+    }
+    if (!ok) { free(rec); free(col); free(jobs); return 0; }
+    qsort(jobs, n_graphs, sizeof(BatchJob), cmp_job_desc);
+
+    Batch b;
+    memset(&b, 0, sizeof(b));
+    b.engine = engine; b.buf = buf; b.rec = rec; b.col = col; b.jobs = jobs;
+    b.n_graphs = n_graphs; b.temps_max = temps_max; b.cancel = cancel;
+    b.out = out; b.out_colorings = out_colorings;
+
+    /* Thread 0 is the caller; a thread that fails to start is just absent */
+    int pool = n_threads < n_graphs ? n_threads : n_graphs;
+    if (pool > BATCH_POOL_MAX) pool = BATCH_POOL_MAX;
+    if (pool < 1) pool = 1;
+    bb_thread_t th[BATCH_POOL_MAX];
+    int started[BATCH_POOL_MAX] = { 0 };
+    for (int i = 1; i < pool; i++) started[i] = bb_thread_start(&th[i], batch_main, &b);
+    batch_main(&b);
+    for (int i = 1; i < pool; i++) if (started[i]) bb_thread_join(th[i]);
+
+    free(rec); free(col); free(jobs);
+    return b.err ? BB_ERR_COLORS : 1;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef BATCH_H
+#define BATCH_H
+
+/*
+ * batch.h
+ * ───────
+ * Many independent graphs in one call. The graphs arrive packed in one
+ * int buffer, one record after the other:
+ *
+ *   n, entries, start[n], deg[n], adj[entries]
+ *
+ * (start[] indexes the record's own adj[], rows sorted as for every
+ * engine). A pool of threads takes the graphs largest first (by
+ * n + entries) and runs the sequential engine on each with the full
+ * temps_max. Results land in out[i], in input order. Colourings are
+ * concatenated in out_colorings, graph i's n entries after those of
+ * graphs 0..i-1.
+ */
+
+#include "coloring.h"
+
+#define BATCH_SEWELL  0
+#define BATCH_FURINI  1
+
+typedef struct {
+    long   nodes;
+    long   cuts;
+    double time;
+    int    K;
+    int    LB;
+    int    UB_init;
+    int    optimal;
+    int    timeout;
+    int    cancelled;   /* stopped by the token (timeout is set too)    */
+    int    backend;     /* ADJ_CSR / ADJ_BITSET                         */
+} BatchResult;
+
+/* ── Solve the n_graphs graphs of buf[0..buf_len) with engine algo ─────
+ * Returns 0 with nothing written for an unknown algo, a record that
+ * overruns buf or fails csr_check(), or an allocation failure, and
+ * BB_ERR_COLORS (all results written) when a graph's engine returned
+ * it (see sewell_solve()), else 1.
+ * bb_cancel() on cancel (may be NULL) stops the running solves; the
+ * graphs not started yet only get their heuristic colouring (timeout
+ * and cancelled = 1).
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int batch_solve(int algo, int* buf, long buf_len, int n_graphs,
+                       int temps_max, int n_threads, const int* cancel,
+                       BatchResult* out, int* out_colorings);
+
+#endif
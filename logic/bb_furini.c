@@ -22,85 +22,207 @@
  *  Any clique Q in R needs |Q| distinct colors  ⟹  χ*(G) ≥ |Q|.
  *  We approximate ω(R) with a greedy clique sorted by degree in R.
  *
+ *  R is not rebuilt per node: the counters of RInc below follow every
+ *  colorier / decolorier of the search, and give R's edges and degrees
+ *  in O(1) each.
+ *
  * This bound is what enabled Furini et al. to prove χ*(DSJC125.9) = 44.
  */
 
 #include "coloring.h"
 #include "heuristics.h"
+#include "parallel.h"
+#include "checkpoint.h"
+#include "reduce.h"
+#include "clique.h"
+#include "frac.h"
+#include "backjump.h"
 #include <stdlib.h>
 #include <string.h>
 
+/* ── Exact clique on small reduced graphs ──────────────────────────────
+ * When R has at most RCLIQUE_EXACT_MAX nodes that could sit in a
+ * UB-clique, they get a BBMC search of at most RCLIQUE_EXACT_NODES nodes.
+ * ─────────────────────────────────────────────────────────────────── */
+#define RCLIQUE_EXACT_MAX    128
+#define RCLIQUE_EXACT_NODES  256
+
+/* ── Scratch needed by lb_reduced() for n vertices and UB ub ──────────
+ * Worst case over both paths; k_used < ub and nu ≤ n at every node.
+ * ─────────────────────────────────────────────────────────────────── */
+static size_t lb_reduced_ws_bytes(int n, int ub) {
+    size_t tot = (size_t)ub + n;
+    size_t rmax = RCLIQUE_EXACT_MAX, rw = (rmax + 63) >> 6;
+    return ARENA_PAD(rmax * rw * sizeof(uint64_t))          /* rmat      */
+         + bbmc_ws_bytes((int)rmax, ub)
+         + ARENA_PAD((size_t)n * sizeof(int))              /* uncolored */
+         + 3 * ARENA_PAD(tot * sizeof(int))                /* degR, nodes, clique
+                                                              (⊇ clique)  */
+         + ARENA_PAD(CSORT_SCRATCH(tot, tot) * sizeof(int)); /* sort scratch */
+}
+
+/* ── Incremental reduced graph ─────────────────────────────────────────
+ * Over the uncolored vertices u, for colors c ≠ d < ub:
+ *   udeg[u]       uncolored neighbours of u          (degree of u in R)
+ *   scnt[c]       #u with c ∈ cset[u]                (s_c ── u edges)
+ *   pcnt[c*ub+d]  #u with c, d ∈ cset[u]             (s_c ── s_d iff > 0)
+ * udeg of a colored vertex is stale; rinc_uncolor() recounts it. Kept
+ * in s->bound_state, below the lb_reduced() mark of s->ws, along with
+ * the worker's lb_frac() column pool when node LPs are on.
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    int       ub;
+    int*      udeg;
+    int*      scnt;
+    int*      pcnt;
+    int*      lst;          /* scratch: the colors of one cset          */
+    FracPool* frac;         /* independent sets of G, or NULL           */
+    double    frac_time;    /* seconds spent in lb_frac() so far        */
+} RInc;
+
+static size_t rinc_bytes(int n, int ub) {
+    return ARENA_PAD(sizeof(RInc)) + ARENA_PAD((size_t)n * sizeof(int))
+         + 2 * ARENA_PAD((size_t)ub * sizeof(int))
+         + ARENA_PAD((size_t)ub * ub * sizeof(int));
+}
+
+static RInc* rinc_push(Arena* a, int n, int ub) {
+    RInc* ri = (RInc*)arena_push(a, sizeof(RInc));
+    if (!ri) return NULL;
+    ri->ub   = ub;
+    ri->frac = NULL;
+    ri->frac_time = 0.0;
+    ri->udeg = (int*)arena_push(a, (size_t)n * sizeof(int));
+    ri->scnt = (int*)arena_push(a, (size_t)ub * sizeof(int));
+    ri->lst  = (int*)arena_push(a, (size_t)ub * sizeof(int));
+    ri->pcnt = (int*)arena_push(a, (size_t)ub * ub * sizeof(int));
+    return ri->udeg && ri->scnt && ri->lst && ri->pcnt ? ri : NULL;
+}
+
+/* Colors of cs into out[], increasing; returns how many */
+CS_INLINE int cs_list(const ColorSet* cs, int* out, int W) {
+    int m = 0;
+    for (int w = 0; w < W; w++)
+        for (ColorSet b = cs[w]; b; b &= b - 1) out[m++] = (w << 6) + CS_LOWEST(b);
+    return m;
+}
+
+/* u enters (dir = 1) or leaves (dir = -1) the uncolored set of R */
+CS_INLINE void rinc_vertex(const BBState* s, RInc* ri, int u, int dir, int W) {
+    int m = cs_list(bb_cset(s, u, W), ri->lst, W);
+    for (int i = 0; i < m; i++) {
+        int c = ri->lst[i];
+        ri->scnt[c] += dir;
+        for (int j = i + 1; j < m; j++) {
+            int d = ri->lst[j];
+            ri->pcnt[c * ri->ub + d] += dir;
+            ri->pcnt[d * ri->ub + c] += dir;
+        }
+    }
+}
+
+/* Uncolored w gains (dir = 1) or loses (dir = -1) color c in its cset */
+CS_INLINE void rinc_sees(const BBState* s, RInc* ri, int w, int c, int dir, int W) {
+    const ColorSet* row = bb_cset(s, w, W);
+    ri->scnt[c] += dir;
+    for (int i = 0; i < W; i++)
+        for (ColorSet b = row[i]; b; b &= b - 1) {
+            int d = (i << 6) + CS_LOWEST(b);
+            if (d == c) continue;
+            ri->pcnt[c * ri->ub + d] += dir;
+            ri->pcnt[d * ri->ub + c] += dir;
+        }
+}
+
+/* ── From scratch, for the coloring in place: O(m + n·dsat²) ────────── */
+static void rinc_rebuild(const BBState* s, RInc* ri) {
+    memset(ri->scnt, 0, (size_t)ri->ub * sizeof(int));
+    memset(ri->pcnt, 0, (size_t)ri->ub * ri->ub * sizeof(int));
+    for (int u = 0; u < s->n; u++) {
+        ri->udeg[u] = 0;
+        if (s->vert[u].color != -1) continue;
+        for (int j = s->start[u]; j < s->start[u] + s->deg[u]; j++)
+            if (s->vert[s->adj[j]].color == -1) ri->udeg[u]++;
+        rinc_vertex(s, ri, u, 1, s->cwords);
+    }
+}
+
+/* ── After colorier_w(s, v, c, …): v leaves R's uncolored set ─────────── */
+CS_INLINE void rinc_color(const BBState* s, RInc* ri, int v, int c, int W, int L) {
+    rinc_vertex(s, ri, v, -1, W);
+    for (int j = s->vert[v].start, e = j + s->vert[v].deg; j < e; j++) {
+        int w = bb_nbr(s, j, L);
+        if (s->vert[w].color != -1) continue;
+        ri->udeg[w]--;
+        if (bb_ccnt(s, w, c, L) == 1) rinc_sees(s, ri, w, c, 1, W);
+    }
+}
+
+/* ── Before decolorier_w(s, v, c, …): the inverse of rinc_color() ────── */
+CS_INLINE void rinc_uncolor(const BBState* s, RInc* ri, int v, int c, int W, int L) {
+    int du = 0;
+    for (int j = s->vert[v].start, e = j + s->vert[v].deg; j < e; j++) {
+        int w = bb_nbr(s, j, L);
+        if (s->vert[w].color != -1) continue;
+        ri->udeg[w]++; du++;
+        if (bb_ccnt(s, w, c, L) == 1) rinc_sees(s, ri, w, c, -1, W);
+    }
+    ri->udeg[v] = du;
+    rinc_vertex(s, ri, v, 1, W);
+}
+
+/* ── Reduced graph R at one node, as seen by reduced_clique() ────────
+ * Node id < k_used → super-node, else uncolored[id - k_used].
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    int             k_used;
+    const RInc*     ri;
+    const int*      uncolored;
+} RGraph;
+
+static int r_adjacent(const BBState* s, const RGraph* R, int a, int b) {
+    int k = R->k_used;
+    if (a < k && b < k) return R->ri->pcnt[a * R->ri->ub + b] > 0;              /* super ── super */
+    if (a < k) return cs_has(bb_cset(s, R->uncolored[b - k], s->cwords), a, s->cwords); /* super ── uncolored */
+    if (b < k) return cs_has(bb_cset(s, R->uncolored[a - k], s->cwords), b, s->cwords);
+    return bb_adjacent(s, R->uncolored[a - k], R->uncolored[b - k]);      /* edge of G */
+}
+
 /* ── Reduced-graph lower bound ─────────────────────────────────────────
  * k_used = number of color classes already used at this node.
  * Returns ω(R), a valid lower bound for χ*(G).
+ * All buffers come from s->ws; the caller restores the arena mark.
  * ─────────────────────────────────────────────────────────────────── */
-static int lb_reduced(BBState* s, int k_used) {
+static int reduced_clique(BBState* s, int k_used) {
+    Arena* ws = &s->ws;
+    const RInc* ri = (const RInc*)s->bound_state;
 
     /* ── Collect uncolored vertices ── */
-    int* uncolored = (int*)malloc(s->n * sizeof(int));
+    int* uncolored = (int*)arena_push(ws, s->n * sizeof(int));
+    if (!uncolored) return k_used; /* safe fallback */
     int nu = 0;
     for (int v = 0; v < s->n; v++)
-        if (s->color[v] == -1) uncolored[nu++] = v;
+        if (s->vert[v].color == -1) uncolored[nu++] = v;
 
-    if (nu == 0) { free(uncolored); return k_used; }
+    if (nu == 0) return k_used;
 
     /* ── Trivial case: no color class yet → greedy clique on whole graph ── */
     if (k_used == 0) {
-        int* subdeg = (int*)calloc(s->n, sizeof(int));
-        for (int i = 0; i < nu; i++) {
-            int v = uncolored[i];
-            for (int j = s->start[v]; j < s->start[v] + s->deg[v]; j++)
-                if (s->color[s->adj[j]] == -1) subdeg[v]++;
-        }
-        /* insertion-sort uncolored by subdeg desc */
-        for (int i = 1; i < nu; i++) {
-            int key = uncolored[i], j2 = i - 1;
-            while (j2 >= 0 && subdeg[uncolored[j2]] < subdeg[key]) {
-                uncolored[j2+1] = uncolored[j2]; j2--;
-            }
-            uncolored[j2+1] = key;
-        }
-        int* clique = (int*)malloc(nu * sizeof(int));
+        int* clique = (int*)arena_push(ws, nu * sizeof(int));
+        if (!clique) return k_used;
+        /* counting-sort uncolored by udeg desc (udeg < nu) */
+        int* scratch = (int*)arena_push(ws, CSORT_SCRATCH(nu, nu) * sizeof(int));
+        if (!scratch) return k_used;
+        csort_desc(uncolored, nu, ri->udeg, nu, scratch);
         int csz = 0;
         for (int i = 0; i < nu; i++) {
             int v = uncolored[i], ok = 1;
+            if (ri->udeg[v] < csz) break;   /* too few neighbours to extend */
             for (int j = 0; j < csz && ok; j++)
-                ok = adj_has(s->adj, s->start[v], s->deg[v], clique[j]);
+                ok = bb_adjacent(s, v, clique[j]);
             if (ok) clique[csz++] = v;
         }
-        int res = csz;
-        free(subdeg); free(clique); free(uncolored);
-        return res;
-    }
-
-    /* ── sees[c][i] = 1 iff uncolored[i] is adjacent to color class c ─── */
-    /* Memory layout: sees[c * nu + i]                                       */
-    size_t sees_sz = (size_t)k_used * nu;
-    uint8_t* sees = (uint8_t*)calloc(sees_sz, 1);
-    if (!sees) { free(uncolored); return k_used; } /* safe fallback */
-
-    for (int i = 0; i < nu; i++) {
-        int u = uncolored[i];
-        ColorSet cs = s->cset[u];
-        while (cs) {
-            int c = CS_LOWEST(cs); cs &= cs - 1;
-            if (c < k_used) sees[(size_t)c * nu + i] = 1;
-        }
-    }
-
-    /* ── super_adj[c * k_used + d] = 1 iff sees[c] ∩ sees[d] ≠ ∅ ────── */
-    uint8_t* sadj = (uint8_t*)calloc((size_t)k_used * k_used, 1);
-    if (!sadj) { free(sees); free(uncolored); return k_used; }
-
-    for (int c = 0; c < k_used; c++) {
-        uint8_t* sc = sees + (size_t)c * nu;
-        for (int d = c + 1; d < k_used; d++) {
-            uint8_t* sd = sees + (size_t)d * nu;
-            int overlap = 0;
-            for (int i = 0; i < nu && !overlap; i++)
-                if (sc[i] && sd[i]) overlap = 1;
-            if (overlap) sadj[c * k_used + d] = sadj[d * k_used + c] = 1;
-        }
+        return csz;
     }
 
     /* ── Degree in R for each node ──────────────────────────────────────
@@ -108,155 +230,503 @@ static int lb_reduced(BBState* s, int k_used) {
      *           node id >= k_used → uncolored[id - k_used]
      * ─────────────────────────────────────────────────────────────────*/
     int total = k_used + nu;
-    int* degR = (int*)calloc(total, sizeof(int));
+    int* degR   = (int*)arena_push(ws, total * sizeof(int));
+    int* nodes  = (int*)arena_push(ws, total * sizeof(int));
+    int* clique = (int*)arena_push(ws, total * sizeof(int));
+    if (!degR || !nodes || !clique) return k_used;
 
     for (int c = 0; c < k_used; c++) {
-        uint8_t* sc = sees + (size_t)c * nu;
-        for (int d = 0; d < k_used; d++) if (sadj[c * k_used + d]) degR[c]++;
-        for (int i = 0; i < nu; i++)    if (sc[i])                  degR[c]++;
+        const int* row = ri->pcnt + (size_t)c * ri->ub;
+        degR[c] = ri->scnt[c];
+        for (int d = 0; d < k_used; d++) if (row[d] > 0) degR[c]++;
     }
     for (int i = 0; i < nu; i++) {
         int v = uncolored[i];
-        degR[k_used + i] = (int)CS_COUNT(s->cset[v]); /* super-node edges */
-        for (int j = s->start[v]; j < s->start[v] + s->deg[v]; j++)
-            if (s->color[s->adj[j]] == -1) degR[k_used + i]++;
+        degR[k_used + i] = cs_count(bb_cset(s, v, s->cwords), s->cwords) /* super-node edges */
+                         + ri->udeg[v];
     }
 
-    /* ── Sort all nodes by degR descending (insertion sort) ─────────── */
-    int* nodes = (int*)malloc(total * sizeof(int));
+    /* ── Sort all nodes by degR descending (counting sort, degR < total) ─ */
+    int* scratch = (int*)arena_push(ws, CSORT_SCRATCH(total, total) * sizeof(int));
+    if (!scratch) return k_used;
     for (int i = 0; i < total; i++) nodes[i] = i;
-    for (int i = 1; i < total; i++) {
-        int key = nodes[i], j = i - 1;
-        while (j >= 0 && degR[nodes[j]] < degR[key]) { nodes[j+1] = nodes[j]; j--; }
-        nodes[j+1] = key;
-    }
+    csort_desc(nodes, total, degR, total, scratch);
 
     /* ── Greedy max clique in R ─────────────────────────────────────── */
-    int* clique = (int*)malloc(total * sizeof(int));
+    RGraph R = { k_used, ri, uncolored };
     int csz = 0;
 
     for (int i = 0; i < total; i++) {
         int a = nodes[i], ok = 1;
+        if (degR[a] < csz) break;     /* too few neighbours to extend */
+        for (int j = 0; j < csz && ok; j++)
+            ok = r_adjacent(s, &R, a, clique[j]);
+        if (ok) clique[csz++] = a;
+    }
 
-        for (int j = 0; j < csz && ok; j++) {
-            int b = clique[j];
-            int adj_ab;
+    /* ── Small R: exact BBMC, only asked whether ω(R) reaches UB ───────
+     * A UB-clique lies within the nodes of degR ≥ UB-1, a prefix of
+     * nodes[]; worth a search when the greedy clique is one short.
+     * ─────────────────────────────────────────────────────────────── */
+    int rn = 0;
+    while (rn < total && degR[nodes[rn]] >= s->UB - 1) rn++;
+    if (csz == s->UB - 1 && rn >= s->UB && rn <= RCLIQUE_EXACT_MAX) {
+        int rw = (rn + 63) >> 6;
+        uint64_t* rmat = (uint64_t*)arena_push_zero(ws, (size_t)rn * rw * sizeof(uint64_t));
+        if (!rmat) return csz;
+        for (int i = 0; i < rn; i++)
+            for (int j = i + 1; j < rn; j++)
+                if (r_adjacent(s, &R, nodes[i], nodes[j])) {
+                    rmat[(size_t)i * rw + (j >> 6)] |= 1ULL << (j & 63);
+                    rmat[(size_t)j * rw + (i >> 6)] |= 1ULL << (i & 63);
+                }
+        int q = bbmc_clique(rn, rmat, rw, s->UB - 1, s->UB,
+                            RCLIQUE_EXACT_NODES, 0.0, s->cancel, ws, NULL);
+        if (q >= s->UB) csz = q;
+    }
 
-            if (a < k_used && b < k_used) {
-                /* super ── super */
-                adj_ab = sadj[a * k_used + b];
+    return csz;
+}
 
-            } else if (a < k_used) {
-                /* super a ── uncolored b */
-                adj_ab = sees[(size_t)a * nu + (b - k_used)];
+static int lb_reduced(BBState* s, int k_used) {
+    size_t mark = s->ws.top;
+    int lb;
+    BB_TIMED(s, BB_PH_BOUND, lb = reduced_clique(s, k_used));
+    s->ws.top = mark;
+    return lb;
+}
 
-            } else if (b < k_used) {
-                /* uncolored a ── super b */
-                adj_ab = sees[(size_t)b * nu + (a - k_used)];
+/* ── LP bound on R (frac.h), at nodes within bb_frac_depth() ─────────
+ * A column of R is a set of independent uncolored vertices plus at most
+ * one super-node. The worker's pool keeps them as independent sets of G
+ * (super-node c ↦ color class c), so they carry over to later nodes:
+ * each node LP starts from the pool mapped onto its R. Node LPs get at
+ * most FRAC_NODE_PIVOTS pivots per node of R and share bb_frac_share() ·
+ * temps_max seconds per worker. Shallow nodes only, so the buffers come
+ * from the heap rather than s->ws.
+ * ─────────────────────────────────────────────────────────────────── */
+#define FRAC_NODE_PIVOTS  10      /* per vertex of R */
+#define FRAC_NODE_MWIS    20000
 
-            } else {
-                /* uncolored ── uncolored: check adjacency in G */
-                int va = uncolored[a - k_used];
-                int vb = uncolored[b - k_used];
-                adj_ab = adj_has(s->adj, s->start[va], s->deg[va], vb);
-            }
+static int reduced_frac(BBState* s, int k_used) {
+    RInc*     ri = (RInc*)s->bound_state;
+    FracPool* gp = ri->frac;
+    double budget = bb_frac_share() * (double)s->temps_max - ri->frac_time;
+    if (budget <= 0.0) return 0;
+    /* The incumbent's classes to start with (shared runs write it under a lock) */
+    if (gp->count == 0 && !s->shared) frac_pool_add_coloring(gp, s->n, s->best_color, s->UB);
 
-            if (!adj_ab) ok = 0;
+    int* uncolored = (int*)malloc(s->n * sizeof(int));
+    if (!uncolored) return 0;
+    int nu = 0;
+    for (int v = 0; v < s->n; v++)
+        if (s->vert[v].color == -1) uncolored[nu++] = v;
+    int total = k_used + nu;
+    if (nu == 0 || total > FRAC_MAX_N) { free(uncolored); return 0; }
+
+    int rw = (total + 63) >> 6, pivots = FRAC_NODE_PIVOTS * total;
+    int cap = gp->count + pivots + 1;
+    uint64_t* rmat = (uint64_t*)calloc((size_t)total * rw, sizeof(uint64_t));
+    uint64_t* rcol = (uint64_t*)malloc(frac_pool_bytes(rw, cap));
+    uint64_t* RS   = (uint64_t*)malloc((size_t)(rw > gp->words ? rw : gp->words) * sizeof(uint64_t));
+    int lb = 0;
+    if (rmat && rcol && RS) {
+        RGraph R = { k_used, ri, uncolored };
+        for (int a = 0; a < total; a++)
+            for (int b = a + 1; b < total; b++)
+                if (r_adjacent(s, &R, a, b)) {
+                    rmat[(size_t)a * rw + (b >> 6)] |= 1ULL << (b & 63);
+                    rmat[(size_t)b * rw + (a >> 6)] |= 1ULL << (a & 63);
+                }
+
+        /* Pool → R: the uncolored part, plus the first super-node it fits */
+        FracPool rp;
+        frac_pool_init(&rp, rcol, rw, cap);
+        for (int j = 0; j < gp->count; j++) {
+            const uint64_t* col = gp->cols + (size_t)j * gp->words;
+            int any = 0;
+            memset(RS, 0, rw * sizeof(uint64_t));
+            for (int i = 0; i < nu; i++)
+                if (bitrow_has(col, uncolored[i])) {
+                    RS[(k_used + i) >> 6] |= 1ULL << ((k_used + i) & 63);
+                    any = 1;
+                }
+            if (!any) continue;
+            for (int c = 0; c < k_used; c++)
+                if (!bitrow_intersects(rmat + (size_t)c * rw, RS, rw)) {
+                    RS[c >> 6] |= 1ULL << (c & 63);
+                    break;
+                }
+            frac_pool_add(&rp, RS);
         }
-        if (ok) clique[csz++] = a;
-    }
 
-    int result = csz;
+        int    seeded = rp.count;
+        double t0 = now_s();
+        lb = frac_lb(total, rmat, rw, &rp, 0, s->UB, pivots, FRAC_NODE_MWIS,
+                     t0 + budget, s->cancel, NULL);
+        ri->frac_time += now_s() - t0;
+
+        /* R → pool: the priced columns, super-node c as color class c */
+        for (int j = seeded; j < rp.count; j++) {
+            const uint64_t* col = rp.cols + (size_t)j * rw;
+            memset(RS, 0, gp->words * sizeof(uint64_t));
+            for (int i = 0; i < nu; i++)
+                if (bitrow_has(col, k_used + i))
+                    RS[uncolored[i] >> 6] |= 1ULL << (uncolored[i] & 63);
+            for (int c = 0; c < k_used; c++) {
+                if (!bitrow_has(col, c)) continue;
+                for (int v = 0; v < s->n; v++)
+                    if (s->vert[v].color == c) RS[v >> 6] |= 1ULL << (v & 63);
+            }
+            frac_pool_add(gp, RS);
+        }
+    }
+    free(uncolored); free(rmat); free(rcol); free(RS);
+    return lb;
+}
 
-    free(sees); free(sadj); free(degR); free(nodes);
-    free(clique); free(uncolored);
-    return result;
+static int lb_frac(BBState* s, int k_used) {
+    int lb;
+    BB_TIMED(s, BB_PH_BOUND, lb = reduced_frac(s, k_used));
+    return lb;
 }
 
-/* ── Recursive B&B ─────────────────────────────────────────────────── */
-static void explore(BBState* s, int nb_col, int k) {
-    if (now_s() - s->time_start > (double)s->temps_max) { s->timeout = 1; return; }
+/* ── Iterative B&B over the explicit frame stack ─────────────────────
+ * Visits nodes in the same order as the recursive DFS: a node is
+ * entered, then either closed (leaf / pruned) or a frame is pushed and
+ * its first branch taken; backtracking advances the top frame. With
+ * s->bj an exhausted frame resumes at its culprit (backjump.h); nodes
+ * cut by the reduced-graph bound count as depending on the whole path.
+ * ─────────────────────────────────────────────────────────────────── */
+CS_INLINE void explore_w(BBState* s, int nb_col, int k, int W, int L) {
+    BBFrame* st = s->stack;
+    RInc* ri = (RInc*)s->bound_state;
+    BJState* bj = s->shared ? NULL : s->bj;
+    int fdepth = ri->frac ? bb_frac_depth() : 0;
+    int sp = bb_replay(s);
+    if (sp) k = bb_child_k(&st[sp - 1]);
+    if (bj) bj_replayed(bj, st, sp);
+    /* Replayed paths and parallel task prefixes bypass rinc_color() */
+    rinc_rebuild(s, ri);
+
+    for (;;) {
+        /* ── Enter the node at depth sp (nb_col + sp vertices coloured) */
+        int up;
+        BB_TIMED(s, BB_PH_CLOCK, up = bb_time_up(s));
+        if (up) s->timeout = s->stop = 1;
+        bb_poll_LB(s);
+        if (s->shared) par_sync(s);
+        if (s->stop) { bb_suspend(s, sp); return; }
+
+        s->nodes_visited++;
+        BB_STAT(bb_stat_node(s, nb_col + sp));
+        if (s->shared) par_progress(s, sp); else bb_progress(s, sp);
+
+        if (nb_col + sp == s->n) {
+            /* Leaf: complete coloring */
+            if (bj && sp) bj_chrono(bj, sp - 1);
+            if (k < s->UB) {
+                s->UB = k;
+                if (s->shared) par_publish(s, k);
+                else bb_copy_colors(s, s->best_color);
+            }
+        } else if (k >= s->UB) {
+            /* Pruning: current cost already ≥ best */
+            if (bj && sp) bj_chrono(bj, sp - 1);
+            s->branches_cut++;
+            BB_STAT(bb_stat_test(s, nb_col + sp, 1));
+        } else if (lb_reduced(s, k) >= s->UB ||
+                   (sp > 0 && sp <= fdepth && lb_frac(s, k) >= s->UB)) {
+            /* ── FURINI: reduced-graph lower bound (clique, or LP) ─── */
+            if (bj && sp) bj_chrono(bj, sp - 1);
+            s->branches_cut++;
+            BB_STAT(bb_stat_test(s, nb_col + sp, 1));
+        } else {
+            BB_STAT(bb_stat_test(s, nb_col + sp, 0));
+            int v;
+            BB_TIMED(s, BB_PH_SELECT, v = select_dsatur(s));
+            if (v != -1) {
+                BBFrame* f = &st[sp++];
+                f->v = v; f->c = -1; f->k = k; f->tried = 0;
+                f->c_limit = (k + 1 < s->UB) ? k + 1 : s->UB - 1;
+                if (bj) bj_push(bj, sp - 1, v);
+            }
+        }
 
-    s->nodes_visited++;
-    maybe_cb(s);
+        /* ── Backtrack: next branch of the top frame, popping exhausted ones */
+        for (;;) {
+            if (sp == 0) return;
+            BBFrame* f = &st[sp - 1];
+            if (f->c >= 0) {
+                BB_TIMED(s, BB_PH_UNCOLOR, rinc_uncolor(s, ri, f->v, f->c, W, L);
+                                           decolorier_w(s, f->v, f->c, W, L));
+                if (s->UB <= s->LB) { bb_unwind(s, sp - 1); return; }
+            }
 
-    /* Leaf */
-    if (nb_col == s->n) {
-        if (k < s->UB) {
-            s->UB = k;
-            memcpy(s->best_color, s->color, s->n * sizeof(int));
+            int c = f->c + 1;
+            for (; c < f->c_limit; c++) {
+                if (cs_has(bb_cset(s, f->v, W), c, W)) continue;
+                int new_k = (c + 1 > f->k) ? c + 1 : f->k;
+                if (new_k >= s->UB) continue;
+                if (bj && bj_refuted(s, bj, sp - 1, f->v, c)) continue;
+
+                /* Parallel: hand untried siblings to idle workers */
+                if (f->tried++ && s->shared && par_wants_work(s) &&
+                    par_offload(s, f->v, c, new_k)) continue;
+                break;
+            }
+            if (c < f->c_limit) {
+                f->c = c;
+                BB_TIMED(s, BB_PH_COLOR, colorier_w(s, f->v, c, W, L);
+                                         rinc_color(s, ri, f->v, c, W, L));
+                k = bb_child_k(f);
+                break;
+            }
+            BB_STAT(bb_stat_branch(s, f->tried));
+            sp--;
+            if (bj) {
+                /* Backjump: undo the frames the dead end does not depend on */
+                for (int h = bj_resume(s, bj, sp); sp > h + 1; sp--) {
+                    BBFrame* g = &st[sp - 1];
+                    BB_TIMED(s, BB_PH_UNCOLOR, rinc_uncolor(s, ri, g->v, g->c, W, L);
+                                               decolorier_w(s, g->v, g->c, W, L));
+                }
+            }
         }
-        return;
     }
+}
 
-    /* Standard pruning */
-    if (k >= s->UB - 1) { s->branches_cut++; return; }
-
-    /* ── FURINI: reduced-graph lower bound ──────────────────────────── */
-    if (lb_reduced(s, k) >= s->UB) { s->branches_cut++; return; }
-    /* ─────────────────────────────────────────────────────────────── */
-
-    int v = select_dsatur(s);
-    if (v == -1) return;
-
-    int c_limit = (k + 1 < s->UB) ? k + 1 : s->UB - 1;
-    for (int c = 0; c < c_limit; c++) {
-        if (CS_HAS(s->cset[v], c)) continue;
-        int new_k = (c + 1 > k) ? c + 1 : k;
-        if (new_k >= s->UB) continue;
+BB_EXPLORE_BY_WIDTH(explore)
 
-        colorier(s, v, c);
-        explore(s, nb_col + 1, new_k);
-        decolorier(s, v, c);
+void furini_explore(BBState* s, int nb_col, int k) { explore_for(s)(s, nb_col, k); }
 
-        if (s->timeout || s->UB == s->LB) return;
+/* ── Arena of lb_reduced() and the RInc kept at its bottom ─────────
+ * Every Furini state needs one: the root, parallel workers, portfolio
+ * members. With node LPs on (bb_frac_depth() > 0), the RInc also gets
+ * a column pool over G.
+ * ─────────────────────────────────────────────────────────────────── */
+int furini_worker_init(BBState* w, const BBState* root) {
+    int n = root->n, ub = root->ncolors, words = (n + 63) >> 6;
+    int frac = bb_frac_depth() > 0;
+    size_t pool = frac ? ARENA_PAD(sizeof(FracPool)) + frac_pool_bytes(words, FRAC_POOL_COLS) : 0;
+    if (!arena_init(&w->ws, rinc_bytes(n, ub) + pool + lb_reduced_ws_bytes(n, ub))) return 0;
+    RInc* ri = rinc_push(&w->ws, n, ub);
+    w->bound_state = ri;
+    if (ri && frac) {
+        FracPool* p = (FracPool*)arena_push(&w->ws, sizeof(FracPool));
+        uint64_t* mem = (uint64_t*)arena_push(&w->ws, frac_pool_bytes(words, FRAC_POOL_COLS));
+        if (p && mem) { frac_pool_init(p, mem, words, FRAC_POOL_COLS); ri->frac = p; }
     }
+    return w->bound_state != NULL;
 }
 
-/* ── Public solver ─────────────────────────────────────────────────── */
-EXPORT void furini_solve(
+/* ── Shared driver for all entry points ────────────────────────────────
+ * x (NULL = cold run) selects a checkpoint to resume, a checkpoint to
+ * write when the time limit stops a sequential run, and warm-start
+ * bounds. Returns 0 when x->ckpt is rejected, with no output written,
+ * BB_ERR_COLORS when the B&B cannot run (see coloring.h), else 1.
+ * ─────────────────────────────────────────────────────────────────── */
+static int solve(
     int n, int* adj, int* start, int* deg,
-    int temps_max, ProgressCB cb,
+    int temps_max, ProgressRing* progress,
     int* out_K, int* out_coloring,
     int* out_LB, int* out_UB_init,
     int* out_optimal, long* out_nodes, long* out_cuts,
-    double* out_time, int* out_timeout
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x
 ) {
-    BBState s;
-    s.n = n; s.adj = adj; s.start = start; s.deg = deg;
+    double t0 = now_s();
+    static const BBStart cold;
+    if (!x) x = &cold;
+
+    CkptInfo info;
+    memset(&info, 0, sizeof(info));
+    if (x->ckpt && !ckpt_read(x->ckpt, x->ckpt_len, CKPT_FURINI, n, adj, start, deg, &info))
+        return 0;
+
+    /* Adjacency backend: bit-matrix for dense graphs, CSR otherwise */
+    int awords = 0;
+    uint64_t* amat = adjmat_wanted(n, deg)
+                   ? adjmat_build(n, adj, start, deg, &awords) : NULL;
+    uint16_t* adj16 = adj16_build(n, adj, start, deg);
+
+    /* Initial bounds (a resumed run keeps the checkpointed ones) */
+    int LB, ub_init;
+    if (x->ckpt) {
+        LB      = info.LB;
+        ub_init = info.ub_init;
+    } else {
+        initial_bounds(n, adj, start, deg, amat, awords, temps_max,
+                       x->known_LB, x->warm_UB, x->warm_coloring, x->cancel,
+                       out_coloring, &LB, &ub_init);
+    }
 
-    s.color      = (int*)malloc(n * sizeof(int));
-    s.cset       = (ColorSet*)calloc(n, sizeof(ColorSet));
-    s.dsat       = (int*)calloc(n, sizeof(int));
+    /* Colors used below the incumbent are always < ub_init */
+    BBState s;
+    int ok = bb_init(&s, n, adj, start, deg, ub_init);
+    s.amat = amat; s.awords = awords;
+    bb_use_adj16(&s, adj16);
+    ok = ok && furini_worker_init(&s, &s);
     s.best_color = out_coloring;
-
-    for (int i = 0; i < n; i++) s.color[i] = -1;
-
-    s.nodes_visited = 0; s.branches_cut = 0;
-    s.temps_max = temps_max; s.timeout = 0;
-    s.callback  = cb;
-    s.time_start = now_s();
-
-    s.LB = greedy_clique(n, adj, start, deg);
-
-    int* init_col = (int*)malloc(n * sizeof(int));
-    int ub_init   = dsatur(n, adj, start, deg, init_col);
-    s.UB = ub_init;
-    memcpy(s.best_color, init_col, n * sizeof(int));
-    free(init_col);
+    s.LB = LB; s.UB = ub_init;
+    s.temps_max = temps_max;
+    s.progress  = progress;
+    s.time_start = t0;
+    s.cancel = x->cancel;
+    s.ext_LB = x->shared_LB;
+    s.bj = (ok && n_threads <= 1) ? bj_new(n, ub_init, x->backjump) : NULL;
+
+    /* Resume: incumbent, counters and the DFS path it stopped on */
+    if (ok && x->ckpt) {
+        ckpt_load(x->ckpt, &info, &s, out_coloring);
+        s.UB            = info.UB;
+        s.nodes_visited = info.nodes;
+        s.branches_cut  = info.cuts;
+    }
 
     *out_LB      = s.LB;
     *out_UB_init = ub_init;
 
-    if (n > 0 && s.LB < s.UB)
-        explore(&s, 0, 0);
+    if (ok && n > 0 && s.LB < s.UB)
+        par_explore(&s, n_threads, explore_for(&s), furini_worker_init);
+
+    double elapsed = info.elapsed + (now_s() - t0);
+    if (x->out_ckpt_len)
+        *x->out_ckpt_len = (ok && s.timeout && n_threads <= 1)
+                         ? ckpt_write(&s, CKPT_FURINI, ub_init, elapsed, x->out_ckpt) : 0;
 
     *out_K       = s.UB;
-    *out_optimal = (s.UB == s.LB) && !s.timeout;
+    *out_optimal = (s.UB <= s.LB) && !s.timeout;
     *out_nodes   = s.nodes_visited;
     *out_cuts    = s.branches_cut;
-    *out_time    = now_s() - s.time_start;
+    *out_time    = elapsed;
     *out_timeout = s.timeout;
+    *out_backend = amat ? ADJ_BITSET : ADJ_CSR;
+    if (x->out_searched) *x->out_searched = ok;
+
+    bj_report(s.bj, x);
+    bj_free(s.bj);
+    BB_STAT(bb_stats_flush(&s));
+    bb_free(&s);
+    return !ok && ub_init > BB_MAX_COLORS && LB < ub_init ? BB_ERR_COLORS : 1;
+}
+
+/* ── Public solver: same contract as sewell_solve() ────────────────── */
+EXPORT int furini_solve(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend
+) {
+    BBStart x;
+    memset(&x, 0, sizeof(x));
+    x.cancel = cancel;
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
+
+/* ── Parallel solver: same contract, explore() on n_threads workers ──
+ * Untried sibling branches are handed to idle workers on demand and
+ * stolen from the front of each worker's deque; the incumbent UB is
+ * shared atomically (see parallel.h). n_threads ≤ 1 is furini_solve().
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int furini_solve_parallel(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend, int n_threads
+) {
+    BBStart x;
+    memset(&x, 0, sizeof(x));
+    x.cancel = cancel;
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, n_threads, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
+
+/* ── Resumable solver: sequential run that can be checkpointed ─────────
+ * ckpt / ckpt_len: checkpoint written by an earlier furini_resume() on
+ * the same graph, or NULL for a fresh run. temps_max is the budget of
+ * this run alone; out_nodes, out_cuts and out_time accumulate over all
+ * runs. When the time limit fires, out_ckpt (bb_checkpoint_bytes(n)
+ * bytes) receives the new checkpoint and *out_ckpt_len its size, else
+ * *out_ckpt_len = 0. Returns 0 if ckpt is invalid for this graph,
+ * else as furini_solve().
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int furini_resume(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend,
+    const unsigned char* ckpt, int ckpt_len,
+    unsigned char* out_ckpt, int* out_ckpt_len
+) {
+    BBStart x = { ckpt, ckpt_len, out_ckpt, out_ckpt_len, 0, NULL, 0, NULL, NULL, 0, NULL, NULL, cancel, NULL };
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = st != 0 && bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
+
+/* ── Warm-started solver: sequential, from known bounds ────────────────
+ * warm_coloring (may be NULL) is a proper colouring with colours
+ * < warm_UB, e.g. a cached best, used as the incumbent instead of
+ * DSATUR (ignored if invalid). known_LB is a proven lower bound. When
+ * known_LB meets the incumbent the call returns it as optimal at once.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int furini_solve_warm(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend,
+    int warm_UB, const int* warm_coloring, int known_LB
+) {
+    BBStart x = { NULL, 0, NULL, NULL, warm_UB, warm_coloring, known_LB, NULL, NULL, 0, NULL, NULL, cancel, NULL };
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
 
-    free(s.color); free(s.cset); free(s.dsat);
+/* ── Solver with conflict-directed backjumping: sequential ─────────────
+ * mode: BB_BACKJUMP and / or BB_NOGOODS (backjump.h), 0 = furini_solve().
+ * out_jumps gets the frames skipped by backjumps, out_nogood_cuts the
+ * branches cut by recorded nogoods (both also among out_cuts).
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int furini_solve_backjump(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend,
+    int mode, long* out_jumps, long* out_nogood_cuts
+) {
+    BBStart x;
+    memset(&x, 0, sizeof(x));
+    x.backjump = mode;
+    x.cancel = cancel;
+    x.out_jumps = out_jumps;
+    x.out_nogood_cuts = out_nogood_cuts;
+    *out_jumps = *out_nogood_cuts = 0;
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
 }
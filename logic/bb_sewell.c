@@ -13,145 +13,431 @@
 
 #include "coloring.h"
 #include "heuristics.h"
+#include "parallel.h"
+#include "checkpoint.h"
+#include "reduce.h"
+#include "backjump.h"
 #include <string.h>
 #include <stdlib.h>
 
+/* ── Sewell score of candidate v ───────────────────────────────────────
+ * Σ over uncoloured u ∈ N(v) of |{0..UB-1} \ (cset[v] ∪ cset[u])|.
+ * Coloured neighbours contribute zero without a branch, so the loop
+ * runs straight through N(v); the single-word case gathers four
+ * neighbours' colours and cset words at a time under AVX2. A colour
+ * is the low half of the first dword of its BBVert (x86 is
+ * little-endian), read at index 4u with scale 4.
+ * ─────────────────────────────────────────────────────────────────── */
+#if BITROW_AVX2
+__attribute__((target("avx2"), always_inline))
+static inline int sewell_score_avx2_l(const BBState* s, int v, ColorSet opts_v, int L) {
+    const __m256i lut  = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low  = _mm256_set1_epi8(0x0f);
+    const __m256i ov   = _mm256_set1_epi64x((long long)opts_v);
+    const __m128i c16  = _mm_set1_epi32(0xffff);
+    const int*      vx   = (const int*)s->vert;
+    const ColorSet* cset = s->cset;
+    int j = s->vert[v].start, e = j + s->vert[v].deg;
+    __m256i acc = _mm256_setzero_si256();
+    for (; j + 4 <= e; j += 4) {
+        __m128i idx  = L == BB_IX16
+                     ? _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(s->adj16 + j)))
+                     : _mm_loadu_si128((const __m128i*)(s->adj + j));
+        __m128i col  = _mm_and_si128(_mm_i32gather_epi32(vx, _mm_slli_epi32(idx, 2), 4), c16);
+        __m256i live = _mm256_cvtepi32_epi64(_mm_cmpeq_epi32(col, c16));
+        __m256i cu   = _mm256_i32gather_epi64((const long long*)cset, idx, 8);
+        __m256i x    = _mm256_and_si256(_mm256_andnot_si256(cu, ov), live);
+        __m256i pc   = _mm256_add_epi8(
+                           _mm256_shuffle_epi8(lut, _mm256_and_si256(x, low)),
+                           _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(pc, _mm256_setzero_si256()));
+    }
+    uint64_t lane[4];
+    _mm256_storeu_si256((__m256i*)lane, acc);
+    int score = (int)(lane[0] + lane[1] + lane[2] + lane[3]);
+    for (; j < e; j++) {
+        int u = bb_nbr(s, j, L);
+        score += CS_COUNT(opts_v & ~cset[u]) & -(s->vert[u].color == -1);
+    }
+    return score;
+}
+
+__attribute__((target("avx2")))
+static int sewell_score_avx2_16(const BBState* s, int v, ColorSet opts_v) {
+    return sewell_score_avx2_l(s, v, opts_v, BB_IX16);
+}
+
+__attribute__((target("avx2")))
+static int sewell_score_avx2_32(const BBState* s, int v, ColorSet opts_v) {
+    return sewell_score_avx2_l(s, v, opts_v, BB_IX32);
+}
+#endif
+
+/* Sewell score of v at any width W; the AVX2 kernel above takes W = 1 */
+CS_INLINE int sewell_score_w(const BBState* s, int v, int W, int L) {
+    const ColorSet* cv = bb_cset(s, v, W);
+    int j = s->vert[v].start, e = j + s->vert[v].deg, score = 0;
+    if (W == 1) {
+        ColorSet opts_v = cs_mask(s->UB) & ~cv[0];
+#if BITROW_AVX2
+        if (e - j >= 8 && bitrow_has_avx2())
+            return L == BB_IX16 ? sewell_score_avx2_16(s, v, opts_v)
+                                : sewell_score_avx2_32(s, v, opts_v);
+#endif
+        for (; j < e; j++) {
+            int u = bb_nbr(s, j, L);
+            score += CS_COUNT(opts_v & ~s->cset[u]) & -(s->vert[u].color == -1);
+        }
+        return score;
+    }
+    for (; j < e; j++) {
+        int u = bb_nbr(s, j, L);
+        score += cs_count_free2(cv, bb_cset(s, u, W), s->UB, W) & -(s->vert[u].color == -1);
+    }
+    return score;
+}
+
 /* ── Sewell vertex selection ───────────────────────────────────────────
  * 1. Max DSAT
  * 2. Tie-break: max degree
  * 3. Tie-break: max Σ_{uncoloured u ∈ N(v)} |opts(v) ∩ opts(u)|
  *    where opts(v) = {0..UB-1} \ cset[v]
+ *
+ * Steps 1-2 come straight from the selection index: the candidates are
+ * the leading run of ranks at level qmax that share the first degree.
+ * W = s->cwords (see ColorSet).
  * ─────────────────────────────────────────────────────────────────── */
-static int select_sewell(const BBState* s) {
-    if (s->n <= 0) return -1;
-
-    /* Pass 1: find max_dsat, max_deg */
-    int max_dsat = -1, max_deg = -1;
-    for (int v = 0; v < s->n; v++) {
-        if (s->color[v] != -1) continue;
-        if (s->dsat[v] > max_dsat) max_dsat = s->dsat[v];
-    }
-    for (int v = 0; v < s->n; v++) {
-        if (s->color[v] != -1 || s->dsat[v] != max_dsat) continue;
-        if (s->deg[v] > max_deg) max_deg = s->deg[v];
-    }
+CS_INLINE int select_sewell_w(const BBState* s, int W, int L) {
+    if (s->qmax < 0) return -1;
 
-    /* Pass 2: collect candidates */
-    int cands[1024];  /* n ≤ 10000 but typical benchmarks ≤ 500 */
-    int nc = 0, first = -1;
-    for (int v = 0; v < s->n; v++) {
-        if (s->color[v] != -1 || s->dsat[v] != max_dsat || s->deg[v] != max_deg)
-            continue;
-        if (first == -1) first = v;
-        if (nc < 1024) cands[nc] = v;
-        nc++;
-    }
-    if (nc <= 1 || s->UB >= 63) return first;
+    int d = s->qmax;
+    int r = q_next(s, d, 0);
+    int first = s->order[r];
 
-    /* Pass 3: Sewell tie-breaking */
-    ColorSet mask = cs_mask(s->UB);
+    int max_deg = s->vert[first].deg;
+    int nxt = q_next(s, d, r + 1);
+    if (nxt < 0 || s->vert[s->order[nxt]].deg != max_deg) return first;
+
+    /* Sewell tie-breaking over the candidate run */
     int best = first, best_score = -1;
 
-    for (int i = 0; i < nc; i++) {
-        int v = cands[i];
-        ColorSet opts_v = mask & ~s->cset[v];
-        int score = 0;
-        for (int j = s->start[v]; j < s->start[v] + s->deg[v]; j++) {
-            int u = s->adj[j];
-            if (s->color[u] != -1) continue;
-            score += CS_COUNT(opts_v & (mask & ~s->cset[u]));
-        }
+    for (; r >= 0; r = q_next(s, d, r + 1)) {
+        int v = s->order[r];
+        if (s->vert[v].deg != max_deg) break;
+        int score = sewell_score_w(s, v, W, L);
         if (score > best_score) { best_score = score; best = v; }
     }
     return best;
 }
 
-/* ── Recursive B&B ─────────────────────────────────────────────────── */
-static void explore(BBState* s, int nb_col, int k) {
-    /* Time check */
-    if (now_s() - s->time_start > (double)s->temps_max) { s->timeout = 1; return; }
+/* ── Iterative B&B over the explicit frame stack ─────────────────────
+ * Visits nodes in the same order as the recursive DFS: a node is
+ * entered, then either closed (leaf / pruned) or a frame is pushed and
+ * its first branch taken; backtracking advances the top frame. With
+ * s->bj an exhausted frame resumes at its culprit (backjump.h).
+ * ─────────────────────────────────────────────────────────────────── */
+CS_INLINE void explore_w(BBState* s, int nb_col, int k, int W, int L) {
+    BBFrame* st = s->stack;
+    BJState* bj = s->shared ? NULL : s->bj;
+    int sp = bb_replay(s);
+    if (sp) k = bb_child_k(&st[sp - 1]);
+    if (bj) bj_replayed(bj, st, sp);
 
-    s->nodes_visited++;
-    maybe_cb(s);
+    for (;;) {
+        /* ── Enter the node at depth sp (nb_col + sp vertices coloured) */
+        int up;
+        BB_TIMED(s, BB_PH_CLOCK, up = bb_time_up(s));
+        if (up) s->timeout = s->stop = 1;
+        bb_poll_LB(s);
+        if (s->shared) par_sync(s);
+        if (s->stop) { bb_suspend(s, sp); return; }
 
-    /* Leaf: complete coloring */
-    if (nb_col == s->n) {
-        if (k < s->UB) {
-            s->UB = k;
-            memcpy(s->best_color, s->color, s->n * sizeof(int));
-        }
-        return;
-    }
+        s->nodes_visited++;
+        BB_STAT(bb_stat_node(s, nb_col + sp));
+        if (s->shared) par_progress(s, sp); else bb_progress(s, sp);
 
-    /* Pruning: current cost already ≥ best */
-    if (k >= s->UB - 1) { s->branches_cut++; return; }
-
-    int v = select_sewell(s);
-    if (v == -1) return;
+        if (nb_col + sp == s->n) {
+            /* Leaf: complete coloring */
+            if (bj && sp) bj_chrono(bj, sp - 1);
+            if (k < s->UB) {
+                s->UB = k;
+                if (s->shared) par_publish(s, k);
+                else bb_copy_colors(s, s->best_color);
+            }
+        } else if (k >= s->UB) {
+            /* Pruning: current cost already ≥ best */
+            if (bj && sp) bj_chrono(bj, sp - 1);
+            s->branches_cut++;
+            BB_STAT(bb_stat_test(s, nb_col + sp, 1));
+        } else {
+            BB_STAT(bb_stat_test(s, nb_col + sp, 0));
+            int v;
+            BB_TIMED(s, BB_PH_SELECT, v = select_sewell_w(s, W, L));
+            if (v != -1) {
+                BBFrame* f = &st[sp++];
+                f->v = v; f->c = -1; f->k = k; f->tried = 0;
+                f->c_limit = (k + 1 < s->UB) ? k + 1 : s->UB - 1;
+                if (bj) bj_push(bj, sp - 1, v);
+            }
+        }
 
-    int c_limit = (k + 1 < s->UB) ? k + 1 : s->UB - 1;
-    for (int c = 0; c < c_limit; c++) {
-        if (CS_HAS(s->cset[v], c)) continue;
-        int new_k = (c + 1 > k) ? c + 1 : k;
-        if (new_k >= s->UB) continue;
+        /* ── Backtrack: next branch of the top frame, popping exhausted ones */
+        for (;;) {
+            if (sp == 0) return;
+            BBFrame* f = &st[sp - 1];
+            if (f->c >= 0) {
+                BB_TIMED(s, BB_PH_UNCOLOR, decolorier_w(s, f->v, f->c, W, L));
+                if (s->UB <= s->LB) { bb_unwind(s, sp - 1); return; }
+            }
 
-        colorier(s, v, c);
-        explore(s, nb_col + 1, new_k);
-        decolorier(s, v, c);
+            int c = f->c + 1;
+            for (; c < f->c_limit; c++) {
+                if (cs_has(bb_cset(s, f->v, W), c, W)) continue;
+                int new_k = (c + 1 > f->k) ? c + 1 : f->k;
+                if (new_k >= s->UB) continue;
+                if (bj && bj_refuted(s, bj, sp - 1, f->v, c)) continue;
 
-        if (s->timeout || s->UB == s->LB) return;
+                /* Parallel: hand untried siblings to idle workers */
+                if (f->tried++ && s->shared && par_wants_work(s) &&
+                    par_offload(s, f->v, c, new_k)) continue;
+                break;
+            }
+            if (c < f->c_limit) {
+                f->c = c;
+                BB_TIMED(s, BB_PH_COLOR, colorier_w(s, f->v, c, W, L));
+                k = bb_child_k(f);
+                break;
+            }
+            BB_STAT(bb_stat_branch(s, f->tried));
+            sp--;
+            if (bj) {
+                /* Backjump: undo the frames the dead end does not depend on */
+                for (int h = bj_resume(s, bj, sp); sp > h + 1; sp--)
+                    BB_TIMED(s, BB_PH_UNCOLOR, decolorier_w(s, st[sp - 1].v, st[sp - 1].c, W, L));
+            }
+        }
     }
 }
 
-/* ── Public solver function ────────────────────────────────────────────
- * All out_* arguments are pre-allocated by the caller.
- * out_coloring must be int[n].
+BB_EXPLORE_BY_WIDTH(explore)
+
+void sewell_explore(BBState* s, int nb_col, int k) { explore_for(s)(s, nb_col, k); }
+
+/* ── Shared driver for all entry points ────────────────────────────────
+ * x (NULL = cold run) selects a checkpoint to resume, a checkpoint to
+ * write when the time limit stops a sequential run, and warm-start
+ * bounds. Returns 0 when x->ckpt is rejected, with no output written,
+ * BB_ERR_COLORS when the B&B cannot run (see coloring.h), else 1.
  * ─────────────────────────────────────────────────────────────────── */
-EXPORT void sewell_solve(
+static int solve(
     int n, int* adj, int* start, int* deg,
-    int temps_max, ProgressCB cb,
+    int temps_max, ProgressRing* progress,
     int* out_K, int* out_coloring,
     int* out_LB, int* out_UB_init,
     int* out_optimal, long* out_nodes, long* out_cuts,
-    double* out_time, int* out_timeout
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x
 ) {
-    BBState s;
-    s.n = n; s.adj = adj; s.start = start; s.deg = deg;
+    double t0 = now_s();
+    static const BBStart cold;
+    if (!x) x = &cold;
 
-    s.color      = (int*)malloc(n * sizeof(int));
-    s.cset       = (ColorSet*)calloc(n, sizeof(ColorSet));
-    s.dsat       = (int*)calloc(n, sizeof(int));
-    s.best_color = out_coloring;
+    CkptInfo info;
+    memset(&info, 0, sizeof(info));
+    if (x->ckpt && !ckpt_read(x->ckpt, x->ckpt_len, CKPT_SEWELL, n, adj, start, deg, &info))
+        return 0;
 
-    for (int i = 0; i < n; i++) s.color[i] = -1;
+    /* Adjacency backend: bit-matrix for dense graphs, CSR otherwise */
+    int awords = 0;
+    uint64_t* amat = adjmat_wanted(n, deg)
+                   ? adjmat_build(n, adj, start, deg, &awords) : NULL;
+    uint16_t* adj16 = adj16_build(n, adj, start, deg);
 
-    s.nodes_visited = 0; s.branches_cut = 0;
-    s.temps_max = temps_max; s.timeout = 0;
-    s.callback  = cb;
-    s.time_start = now_s();
+    /* Initial bounds (a resumed run keeps the checkpointed ones) */
+    int LB, ub_init;
+    if (x->ckpt) {
+        LB      = info.LB;
+        ub_init = info.ub_init;
+    } else {
+        initial_bounds(n, adj, start, deg, amat, awords, temps_max,
+                       x->known_LB, x->warm_UB, x->warm_coloring, x->cancel,
+                       out_coloring, &LB, &ub_init);
+    }
 
-    /* Initial bounds */
-    s.LB = greedy_clique(n, adj, start, deg);
+    /* Colors used below the incumbent are always < ub_init */
+    BBState s;
+    int ok = bb_init(&s, n, adj, start, deg, ub_init);
+    s.amat = amat; s.awords = awords;
+    bb_use_adj16(&s, adj16);
+    s.best_color = out_coloring;
+    s.LB = LB; s.UB = ub_init;
+    s.temps_max = temps_max;
+    s.progress  = progress;
+    s.time_start = t0;
+    s.cancel = x->cancel;
+    s.ext_LB = x->shared_LB;
+    s.bj = (ok && n_threads <= 1) ? bj_new(n, ub_init, x->backjump) : NULL;
 
-    int* init_col = (int*)malloc(n * sizeof(int));
-    int ub_init   = dsatur(n, adj, start, deg, init_col);
-    s.UB = ub_init;
-    memcpy(s.best_color, init_col, n * sizeof(int));
-    free(init_col);
+    /* Resume: incumbent, counters and the DFS path it stopped on */
+    if (ok && x->ckpt) {
+        ckpt_load(x->ckpt, &info, &s, out_coloring);
+        s.UB            = info.UB;
+        s.nodes_visited = info.nodes;
+        s.branches_cut  = info.cuts;
+    }
 
-    *out_LB     = s.LB;
+    *out_LB      = s.LB;
     *out_UB_init = ub_init;
 
-    /* B&B */
-    if (n > 0 && s.LB < s.UB)
-        explore(&s, 0, 0);
+    if (ok && n > 0 && s.LB < s.UB)
+        par_explore(&s, n_threads, explore_for(&s), NULL);
+
+    double elapsed = info.elapsed + (now_s() - t0);
+    if (x->out_ckpt_len)
+        *x->out_ckpt_len = (ok && s.timeout && n_threads <= 1)
+                         ? ckpt_write(&s, CKPT_SEWELL, ub_init, elapsed, x->out_ckpt) : 0;
 
     *out_K       = s.UB;
-    *out_optimal = (s.UB == s.LB) && !s.timeout;
+    *out_optimal = (s.UB <= s.LB) && !s.timeout;
     *out_nodes   = s.nodes_visited;
     *out_cuts    = s.branches_cut;
-    *out_time    = now_s() - s.time_start;
+    *out_time    = elapsed;
     *out_timeout = s.timeout;
+    *out_backend = amat ? ADJ_BITSET : ADJ_CSR;
+    if (x->out_searched) *x->out_searched = ok;
 
-    free(s.color); free(s.cset); free(s.dsat);
+    bj_report(s.bj, x);
+    bj_free(s.bj);
+    BB_STAT(bb_stats_flush(&s));
+    bb_free(&s);
+    return !ok && ub_init > BB_MAX_COLORS && LB < ub_init ? BB_ERR_COLORS : 1;
+}
+
+/* ── Public solver function ────────────────────────────────────────────
+ * All out_* arguments are pre-allocated by the caller.
+ * out_coloring must be int[n]. cancel (may be NULL) is this run's
+ * token for bb_cancel(); *out_cancelled = 1 when it stopped the run
+ * early (out_timeout is then set too). Returns 1, or BB_ERR_COLORS
+ * when the start-up colouring needs more than BB_MAX_COLORS colours
+ * and LB is below it: the B&B cannot run and the outputs hold the
+ * heuristic bounds.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int sewell_solve(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend
+) {
+    BBStart x;
+    memset(&x, 0, sizeof(x));
+    x.cancel = cancel;
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
+
+/* ── Parallel solver: same contract, explore() on n_threads workers ──
+ * Untried sibling branches are handed to idle workers on demand and
+ * stolen from the front of each worker's deque; the incumbent UB is
+ * shared atomically (see parallel.h). n_threads ≤ 1 is sewell_solve().
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int sewell_solve_parallel(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend, int n_threads
+) {
+    BBStart x;
+    memset(&x, 0, sizeof(x));
+    x.cancel = cancel;
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, n_threads, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
+
+/* ── Resumable solver: sequential run that can be checkpointed ─────────
+ * ckpt / ckpt_len: checkpoint written by an earlier sewell_resume() on
+ * the same graph, or NULL for a fresh run. temps_max is the budget of
+ * this run alone; out_nodes, out_cuts and out_time accumulate over all
+ * runs. When the time limit fires, out_ckpt (bb_checkpoint_bytes(n)
+ * bytes) receives the new checkpoint and *out_ckpt_len its size, else
+ * *out_ckpt_len = 0. Returns 0 if ckpt is invalid for this graph,
+ * else as sewell_solve().
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int sewell_resume(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend,
+    const unsigned char* ckpt, int ckpt_len,
+    unsigned char* out_ckpt, int* out_ckpt_len
+) {
+    BBStart x = { ckpt, ckpt_len, out_ckpt, out_ckpt_len, 0, NULL, 0, NULL, NULL, 0, NULL, NULL, cancel, NULL };
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = st != 0 && bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
+
+/* ── Warm-started solver: sequential, from known bounds ────────────────
+ * warm_coloring (may be NULL) is a proper colouring with colours
+ * < warm_UB, e.g. a cached best, used as the incumbent instead of
+ * DSATUR (ignored if invalid). known_LB is a proven lower bound. When
+ * known_LB meets the incumbent the call returns it as optimal at once.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int sewell_solve_warm(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend,
+    int warm_UB, const int* warm_coloring, int known_LB
+) {
+    BBStart x = { NULL, 0, NULL, NULL, warm_UB, warm_coloring, known_LB, NULL, NULL, 0, NULL, NULL, cancel, NULL };
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
+
+/* ── Solver with conflict-directed backjumping: sequential ─────────────
+ * mode: BB_BACKJUMP and / or BB_NOGOODS (backjump.h), 0 = sewell_solve().
+ * out_jumps gets the frames skipped by backjumps, out_nogood_cuts the
+ * branches cut by recorded nogoods (both also among out_cuts).
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int sewell_solve_backjump(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend,
+    int mode, long* out_jumps, long* out_nogood_cuts
+) {
+    BBStart x;
+    memset(&x, 0, sizeof(x));
+    x.backjump = mode;
+    x.cancel = cancel;
+    x.out_jumps = out_jumps;
+    x.out_nogood_cuts = out_nogood_cuts;
+    *out_jumps = *out_nogood_cuts = 0;
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, 1, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
 }
@@ -0,0 +1,293 @@
+/*
+ * bench.c
+ * ───────
+ * Headless benchmark driver: one engine, one DIMACS instance, one trial
+ * per process, so the peak RSS it reports belongs to that run alone.
+ * Built and driven by logic/bench.py.
+ *
+ *   bench <engine> <file.col> <seconds> [threads] [relabel]
+ *
+ * relabel: none (default), degeneracy, rcm or bfs (see relabel.h).
+ *
+ * Prints one JSON object on stdout: the solver outputs plus nodes/s,
+ * cut rate, time to the final UB (from the progress ring, so within
+ * PROGRESS_EVERY nodes), time to a proven optimum and peak RSS (KiB).
+ * Exit status: 0 ok, 1 bad usage / unreadable instance, 2 out of memory.
+ */
+
+#define _XOPEN_SOURCE 700       /* nanosleep, getrusage under -std=c99 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "parallel.h"
+#include "relabel.h"
+
+#ifdef _WIN32
+  #include <psapi.h>
+#else
+  #include <sys/resource.h>
+#endif
+
+/* ── Engine entry points (bb_sewell.c, bb_furini.c, portfolio.c) ───── */
+#define SOLVE_ARGS int n, int* adj, int* start, int* deg,                 \
+                   int temps_max, ProgressRing* progress,                 \
+                   const int* cancel,                                     \
+                   int* out_K, int* out_coloring,                         \
+                   int* out_LB, int* out_UB_init,                         \
+                   int* out_optimal, long* out_nodes, long* out_cuts,     \
+                   double* out_time, int* out_timeout,                    \
+                   int* out_cancelled, int* out_backend
+
+EXPORT int sewell_solve(SOLVE_ARGS);
+EXPORT int furini_solve(SOLVE_ARGS);
+EXPORT int sewell_solve_parallel(SOLVE_ARGS, int n_threads);
+EXPORT int furini_solve_parallel(SOLVE_ARGS, int n_threads);
+EXPORT int portfolio_solve(SOLVE_ARGS, int n_threads, int* out_winner);
+
+/* loader.c */
+EXPORT int  dimacs_scan(const char* buf, long len, int* out_n, long* out_edges);
+EXPORT long dimacs_csr(const char* buf, long len, int n, long edges,
+                       int* adj, int* start, int* deg);
+
+typedef struct {
+    int    n;
+    int*   adj;
+    int*   start;
+    int*   deg;
+    int    temps_max;
+    int    n_threads;
+    ProgressRing* ring;
+
+    int    K, LB, UB_init, optimal, timeout, cancelled, backend;
+    long   nodes, cuts;
+    double time;
+    int*   coloring;
+} Run;
+
+static void run_sewell(Run* r) {
+    sewell_solve(r->n, r->adj, r->start, r->deg, r->temps_max, r->ring, NULL, &r->K,
+                 r->coloring, &r->LB, &r->UB_init, &r->optimal, &r->nodes, &r->cuts,
+                 &r->time, &r->timeout, &r->cancelled, &r->backend);
+}
+
+static void run_furini(Run* r) {
+    furini_solve(r->n, r->adj, r->start, r->deg, r->temps_max, r->ring, NULL, &r->K,
+                 r->coloring, &r->LB, &r->UB_init, &r->optimal, &r->nodes, &r->cuts,
+                 &r->time, &r->timeout, &r->cancelled, &r->backend);
+}
+
+static void run_sewell_par(Run* r) {
+    sewell_solve_parallel(r->n, r->adj, r->start, r->deg, r->temps_max, r->ring, NULL,
+                          &r->K, r->coloring, &r->LB, &r->UB_init, &r->optimal,
+                          &r->nodes, &r->cuts, &r->time, &r->timeout, &r->cancelled,
+                          &r->backend, r->n_threads);
+}
+
+static void run_furini_par(Run* r) {
+    furini_solve_parallel(r->n, r->adj, r->start, r->deg, r->temps_max, r->ring, NULL,
+                          &r->K, r->coloring, &r->LB, &r->UB_init, &r->optimal,
+                          &r->nodes, &r->cuts, &r->time, &r->timeout, &r->cancelled,
+                          &r->backend, r->n_threads);
+}
+
+static void run_portfolio(Run* r) {
+    int winner;
+    portfolio_solve(r->n, r->adj, r->start, r->deg, r->temps_max, r->ring, NULL, &r->K,
+                    r->coloring, &r->LB, &r->UB_init, &r->optimal, &r->nodes,
+                    &r->cuts, &r->time, &r->timeout, &r->cancelled, &r->backend,
+                    r->n_threads, &winner);
+}
+
+static const char* const RELABEL_NAMES[] = { "none", "degeneracy", "rcm", "bfs" };
+#define N_RELABEL ((int)(sizeof(RELABEL_NAMES) / sizeof(RELABEL_NAMES[0])))
+
+/* New engines: one line here and they are benchmarkable */
+static const struct { const char* name; void (*run)(Run*); } ENGINES[] = {
+    { "sewell",          run_sewell     },
+    { "furini",          run_furini     },
+    { "sewell_parallel", run_sewell_par },
+    { "furini_parallel", run_furini_par },
+    { "portfolio",       run_portfolio  },
+};
+#define N_ENGINES ((int)(sizeof(ENGINES) / sizeof(ENGINES[0])))
+
+/* ── Progress watcher: earliest time the incumbent reached each UB ─────
+ * Drains the ring on its own thread so long runs cannot lap it.
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    ProgressRing* ring;
+    uint64_t      cursor;
+    volatile int  done;
+    int           best_UB;      /* smallest UB seen so far, 0 = none   */
+    double        t_best;       /*   and the first record that had it  */
+} Watch;
+
+static void watch_drain(Watch* w) {
+    static ProgressRec buf[PROGRESS_RING_CAP];
+    int got;
+    while ((got = progress_ring_read(w->ring, &w->cursor, buf, PROGRESS_RING_CAP)) > 0) {
+        for (int i = 0; i < got; i++) {
+            if (w->best_UB == 0 || buf[i].UB < w->best_UB) {
+                w->best_UB = buf[i].UB;
+                w->t_best  = buf[i].t;
+            }
+        }
+    }
+}
+
+static void sleep_ms(int ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts = { 0, ms * 1000000L };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static BB_THREAD_RET watch_main(void* arg) {
+    Watch* w = (Watch*)arg;
+    while (!__atomic_load_n(&w->done, __ATOMIC_ACQUIRE)) {
+        watch_drain(w);
+        sleep_ms(10);
+    }
+    BB_THREAD_RETURN;
+}
+
+/* ── Peak resident set of this process, KiB (-1 if unknown) ─────────── */
+static long peak_rss_kib(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return -1;
+    return (long)(pmc.PeakWorkingSetSize / 1024);
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return -1;
+  #ifdef __APPLE__
+    return (long)(ru.ru_maxrss / 1024);     /* bytes on macOS */
+  #else
+    return (long)ru.ru_maxrss;
+  #endif
+#endif
+}
+
+/* ── Whole file into a malloc'd buffer ──────────────────────────────── */
+static char* read_file(const char* path, long* out_len) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    char* buf = NULL;
+    long  len = -1;
+    if (fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0)
+        buf = (char*)malloc(len + 1);
+    if (buf && (long)fread(buf, 1, len, f) != len) { free(buf); buf = NULL; }
+    fclose(f);
+    *out_len = len;
+    return buf;
+}
+
+/* ── Colouring check: every edge bichromatic, colours in [0, K) ─────── */
+static int coloring_valid(const Run* r) {
+    for (int v = 0; v < r->n; v++) {
+        int c = r->coloring[v];
+        if (c < 0 || c >= r->K) return 0;
+        for (int j = r->start[v]; j < r->start[v] + r->deg[v]; j++)
+            if (r->coloring[r->adj[j]] == c) return 0;
+    }
+    return 1;
+}
+
+/* ── s as a JSON string literal ─────────────────────────────────────── */
+static void json_str(const char* s) {
+    putchar('"');
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') putchar('\\');
+        if ((unsigned char)*s >= 0x20) putchar(*s);
+    }
+    putchar('"');
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <engine> <file.col> <seconds> [threads] [relabel]\nengines:",
+                argv[0]);
+        for (int i = 0; i < N_ENGINES; i++) fprintf(stderr, " %s", ENGINES[i].name);
+        fprintf(stderr, "\nrelabel:");
+        for (int i = 0; i < N_RELABEL; i++) fprintf(stderr, " %s", RELABEL_NAMES[i]);
+        fprintf(stderr, "\n");
+        return 1;
+    }
+    void (*run)(Run*) = NULL;
+    for (int i = 0; i < N_ENGINES; i++)
+        if (strcmp(argv[1], ENGINES[i].name) == 0) run = ENGINES[i].run;
+    if (!run) { fprintf(stderr, "unknown engine: %s\n", argv[1]); return 1; }
+    int relabel = argc > 5 ? -1 : RELABEL_NONE;
+    for (int i = 0; argc > 5 && i < N_RELABEL; i++)
+        if (strcmp(argv[5], RELABEL_NAMES[i]) == 0) relabel = i;
+    if (relabel < 0) { fprintf(stderr, "unknown relabel mode: %s\n", argv[5]); return 1; }
+    bb_set_relabel(relabel);
+
+    long  len;
+    char* buf = read_file(argv[2], &len);
+    if (!buf) { fprintf(stderr, "cannot read %s\n", argv[2]); return 1; }
+
+    Run r;
+    memset(&r, 0, sizeof(r));
+    long edges;
+    if (dimacs_scan(buf, len, &r.n, &edges) != 1) {
+        fprintf(stderr, "%s: not a DIMACS graph\n", argv[2]);
+        free(buf);
+        return 1;
+    }
+    r.temps_max = atoi(argv[3]);
+    r.n_threads = argc > 4 ? atoi(argv[4]) : 0;
+    r.adj      = (int*)malloc((size_t)(2 * edges + 1) * sizeof(int));
+    r.start    = (int*)malloc((size_t)r.n * sizeof(int));
+    r.deg      = (int*)malloc((size_t)r.n * sizeof(int));
+    r.coloring = (int*)malloc((size_t)r.n * sizeof(int));
+    r.ring     = progress_ring_new();
+    if (!r.adj || !r.start || !r.deg || !r.coloring || !r.ring) return 2;
+    long m = dimacs_csr(buf, len, r.n, edges, r.adj, r.start, r.deg) / 2;
+    free(buf);
+
+    Watch w;
+    memset(&w, 0, sizeof(w));
+    w.ring = r.ring;
+    bb_thread_t th;
+    int watching = bb_thread_start(&th, watch_main, &w);
+
+    run(&r);
+
+    if (watching) {
+        __atomic_store_n(&w.done, 1, __ATOMIC_RELEASE);
+        bb_thread_join(th);
+    }
+    watch_drain(&w);
+
+    /* The incumbent only reaches K through a recorded node, unless the
+       start-up bounds already closed the gap (no B&B at all)          */
+    double t_best = (w.best_UB != 0 && w.best_UB <= r.K) ? w.t_best : r.time;
+    double nps    = r.time > 0.0 ? (double)r.nodes / r.time : 0.0;
+    double cut    = r.nodes > 0 ? (double)r.cuts / (double)r.nodes : 0.0;
+    int    proven = r.optimal || !r.timeout;     /* a finished tree proves K */
+
+    printf("{\"engine\": ");
+    json_str(argv[1]);
+    printf(", \"instance\": ");
+    json_str(argv[2]);
+    printf(", \"relabel\": \"%s\"", RELABEL_NAMES[relabel]);
+    printf(", \"n\": %d, \"m\": %ld, \"threads\": %d, \"budget\": %d, "
+           "\"K\": %d, \"LB\": %d, \"UB_init\": %d, \"optimal\": %s, \"timeout\": %s, "
+           "\"valid\": %s, \"nodes\": %ld, \"cuts\": %ld, \"time\": %.6f, "
+           "\"nodes_per_s\": %.1f, \"cut_rate\": %.6f, \"t_best\": %.6f, \"t_opt\": ",
+           r.n, m, r.n_threads, r.temps_max, r.K, r.LB, r.UB_init,
+           r.optimal ? "true" : "false", r.timeout ? "true" : "false",
+           coloring_valid(&r) ? "true" : "false", r.nodes, r.cuts,
+           r.time, nps, cut, t_best);
+    if (proven) printf("%.6f", r.time); else printf("null");
+    printf(", \"peak_rss_kib\": %ld, \"backend\": \"%s\"}\n",
+           peak_rss_kib(), r.backend == ADJ_BITSET ? "bitset" : "csr");
+
+    progress_ring_free(r.ring);
+    free(r.adj); free(r.start); free(r.deg); free(r.coloring);
+    return 0;
+}
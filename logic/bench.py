@@ -0,0 +1,289 @@
+"""
+logic/bench.py
+──────────────
+Headless benchmark over a directory of DIMACS .col instances, with
+regression checks against a stored baseline.
+
+    python -m logic.bench SUITE_DIR [--engines sewell,furini] [--time 10]
+                          [--trials 3] [--threads N] [--pattern '*.col']
+                          [--relabel none,rcm] [--perf]
+                          [--json out.json] [--csv out.csv]
+                          [--baseline base.json] [--tolerance 0.10]
+
+Every (instance, engine, trial) runs in its own process of the C driver
+logic/bench.c (compiled on demand next to this file, like the solver
+library), so timings carry no Python overhead and peak RSS is per run.
+Trials are summarised by their median; K is the best trial and t_opt is
+null unless every trial proved its K optimal.
+
+--relabel runs every engine once per vertex order (relabel.h), so one
+table compares them side by side. --perf runs each trial under
+`perf stat` (Linux) and adds L1-dcache and last-level-cache load miss
+rates; they are null where perf or the hardware counters are missing.
+
+With --baseline (a JSON file written by --json), an instance/engine/relabel
+row regresses when its K gets worse, it no longer proves optimality, or its
+nodes/s or t_opt move the wrong way by more than --tolerance. Any
+regression makes the exit status 1.
+"""
+
+import argparse
+import csv
+import fnmatch
+import json
+import os
+import statistics
+import subprocess
+import sys
+
+from logic.solver import _C_SOURCES, _C_HEADERS, _HERE, _IS_WINDOWS
+
+_DRIVER_SRC  = os.path.join(_HERE, "bench.c")
+_DRIVER_PATH = os.path.join(_HERE, "bench.exe" if _IS_WINDOWS else "bench")
+
+ENGINES = ("sewell", "furini", "sewell_parallel", "furini_parallel", "portfolio")
+RELABEL = ("none", "degeneracy", "rcm", "bfs")
+
+# Summary columns, in CSV order
+FIELDS = ("instance", "engine", "relabel", "n", "m", "trials", "K", "LB", "optimal",
+          "nodes", "time", "nodes_per_s", "cut_rate", "t_best", "t_opt",
+          "peak_rss_kib", "l1_miss_rate", "llc_miss_rate", "backend")
+
+# perf stat events: (loads, misses) per reported miss rate
+_PERF_EVENTS = {
+    "l1_miss_rate":  ("L1-dcache-loads", "L1-dcache-load-misses"),
+    "llc_miss_rate": ("LLC-loads", "LLC-load-misses"),
+}
+
+# t_opt below this (s) is too short to compare against a baseline
+_MIN_T_OPT = 0.05
+
+
+# ── Driver build ──────────────────────────────────────────────────────────
+
+def build_driver() -> str:
+    """Compile bench.c with the solver sources if out of date; returns its path."""
+    sources = [_DRIVER_SRC, *_C_SOURCES]
+    if os.path.exists(_DRIVER_PATH):
+        mtime = os.path.getmtime(_DRIVER_PATH)
+        if all(os.path.getmtime(p) <= mtime for p in sources + _C_HEADERS if os.path.exists(p)):
+            return _DRIVER_PATH
+    flags = [
+        "gcc", "-O2", "-std=c99",
+        *(["-static-libgcc"] if _IS_WINDOWS else ["-pthread"]),
+        "-I", _HERE,
+        "-o", _DRIVER_PATH,
+        *sources,
+        *(["-lpsapi"] if _IS_WINDOWS else []),
+    ]
+    try:
+        result = subprocess.run(flags, capture_output=True, text=True, timeout=120)
+    except FileNotFoundError:
+        raise RuntimeError("gcc not found on PATH (see logic/solver.py).")
+    if result.returncode != 0:
+        raise RuntimeError(f"bench driver compilation failed:\n{result.stderr}")
+    return _DRIVER_PATH
+
+
+# ── Runs ──────────────────────────────────────────────────────────────────
+
+def _perf_rates(stderr: str) -> dict:
+    """Miss rates from `perf stat -x,` output; None where a counter is missing."""
+    counts = {}
+    for line in stderr.splitlines():
+        parts = line.split(",")
+        if len(parts) >= 3:
+            try:
+                counts[parts[2]] = float(parts[0])
+            except ValueError:
+                pass            # <not supported> / <not counted>
+    rates = {}
+    for key, (loads, misses) in _PERF_EVENTS.items():
+        n = counts.get(loads)
+        rates[key] = counts[misses] / n if n and misses in counts else None
+    return rates
+
+
+def run_once(driver: str, engine: str, path: str, seconds: int, threads: int,
+             relabel: str = "none", perf: bool = False) -> dict:
+    """One trial in a fresh driver process; returns its JSON record."""
+    args = [driver, engine, path, str(seconds), str(threads), relabel]
+    if perf:
+        events = ",".join(e for pair in _PERF_EVENTS.values() for e in pair)
+        args = ["perf", "stat", "-x", ",", "-e", events, "--", *args]
+    # The B&B stops at its budget; the margin covers start-up and pre-solve
+    try:
+        proc = subprocess.run(args, capture_output=True, text=True, timeout=seconds * 2 + 60)
+    except FileNotFoundError:
+        raise RuntimeError("perf not found on PATH (needed by --perf).")
+    if proc.returncode != 0:
+        raise RuntimeError(f"{engine} on {path}: {proc.stderr.strip() or proc.returncode}")
+    rec = json.loads(proc.stdout)
+    if not rec["valid"]:
+        raise RuntimeError(f"{engine} on {path}: invalid colouring with K={rec['K']}")
+    rec.update(_perf_rates(proc.stderr) if perf else dict.fromkeys(_PERF_EVENTS))
+    return rec
+
+
+def summarize(instance: str, engine: str, trials: list) -> dict:
+    """Median over trials; K / LB are the best trial, t_opt needs all proven."""
+    def med(key):
+        return statistics.median(t[key] for t in trials)
+
+    def med_known(key):
+        known = [t[key] for t in trials if t[key] is not None]
+        return statistics.median(known) if known else None
+
+    t_opt = None
+    if all(t["t_opt"] is not None for t in trials):
+        t_opt = med("t_opt")
+    first = trials[0]
+    return {
+        "instance":     instance,
+        "engine":       engine,
+        "relabel":      first["relabel"],
+        "n":            first["n"],
+        "m":            first["m"],
+        "trials":       len(trials),
+        "K":            min(t["K"] for t in trials),
+        "LB":           max(t["LB"] for t in trials),
+        "optimal":      t_opt is not None,
+        "nodes":        int(med("nodes")),
+        "time":         med("time"),
+        "nodes_per_s":  med("nodes_per_s"),
+        "cut_rate":     med("cut_rate"),
+        "t_best":       med("t_best"),
+        "t_opt":        t_opt,
+        "peak_rss_kib": max(t["peak_rss_kib"] for t in trials),
+        "l1_miss_rate":  med_known("l1_miss_rate"),
+        "llc_miss_rate": med_known("llc_miss_rate"),
+        "backend":      first["backend"],
+    }
+
+
+def run_suite(suite: str, engines: list, seconds: int, trials: int,
+              threads: int = 0, pattern: str = "*.col", log=None,
+              relabels: tuple = ("none",), perf: bool = False) -> list:
+    driver = build_driver()
+    threads = threads or (os.cpu_count() or 1)
+    files = sorted(f for f in os.listdir(suite) if fnmatch.fnmatch(f, pattern))
+    rows = []
+    for f in files:
+        instance = os.path.splitext(f)[0]
+        for engine in engines:
+            for relabel in relabels:
+                recs = [run_once(driver, engine, os.path.join(suite, f), seconds, threads,
+                                 relabel, perf)
+                        for _ in range(trials)]
+                row = summarize(instance, engine, recs)
+                rows.append(row)
+                if log:
+                    log(row)
+    return rows
+
+
+# ── Baseline comparison ───────────────────────────────────────────────────
+
+def compare(rows: list, baseline: list, tolerance: float) -> list:
+    """Regression messages of rows against baseline rows (same keys)."""
+    # Baselines from before --relabel have no relabel column
+    base = {(b["instance"], b["engine"], b.get("relabel", "none")): b for b in baseline}
+    out = []
+    for r in rows:
+        b = base.get((r["instance"], r["engine"], r["relabel"]))
+        if b is None:
+            continue
+        tag = f"{r['instance']} / {r['engine']}"
+        if r["relabel"] != "none":
+            tag += f" / {r['relabel']}"
+        if r["K"] > b["K"]:
+            out.append(f"{tag}: K {b['K']} -> {r['K']}")
+        if b["optimal"] and not r["optimal"]:
+            out.append(f"{tag}: optimality no longer proven within the budget")
+        if b["nodes_per_s"] > 0 and r["nodes_per_s"] < b["nodes_per_s"] * (1 - tolerance):
+            out.append(f"{tag}: nodes/s {b['nodes_per_s']:,.0f} -> {r['nodes_per_s']:,.0f}")
+        if (b["t_opt"] is not None and r["t_opt"] is not None and b["t_opt"] >= _MIN_T_OPT
+                and r["t_opt"] > b["t_opt"] * (1 + tolerance)):
+            out.append(f"{tag}: t_opt {b['t_opt']:.3f}s -> {r['t_opt']:.3f}s")
+    return out
+
+
+# ── Output ────────────────────────────────────────────────────────────────
+
+def write_json(path: str, rows: list, meta: dict) -> None:
+    with open(path, "w", encoding="utf-8") as f:
+        json.dump({"meta": meta, "results": rows}, f, indent=1)
+
+
+def write_csv(path: str, rows: list) -> None:
+    with open(path, "w", newline="", encoding="utf-8") as f:
+        w = csv.DictWriter(f, fieldnames=FIELDS)
+        w.writeheader()
+        w.writerows(rows)
+
+
+def _log_row(r: dict) -> None:
+    t_opt = f"{r['t_opt']:.3f}s" if r["t_opt"] is not None else "—"
+    misses = ""
+    if r["l1_miss_rate"] is not None or r["llc_miss_rate"] is not None:
+        misses = "".join(f"  {name}={r[key]:.2%}" if r[key] is not None else f"  {name}=—"
+                         for name, key in (("L1", "l1_miss_rate"), ("LLC", "llc_miss_rate")))
+    print(f"{r['instance']:<16} {r['engine']:<16} {r['relabel']:<10} K={r['K']:<4} "
+          f"LB={r['LB']:<4} nodes/s={r['nodes_per_s']:>12,.0f}  cut={r['cut_rate']:.3f}  "
+          f"t_best={r['t_best']:.3f}s  t_opt={t_opt:<9} rss={r['peak_rss_kib']:,}KiB{misses}",
+          flush=True)
+
+
+def main(argv=None) -> int:
+    ap = argparse.ArgumentParser(prog="python -m logic.bench",
+                                 description="Benchmark the B&B engines over DIMACS instances.")
+    ap.add_argument("suite", help="directory of .col instances")
+    ap.add_argument("--engines", default="sewell,furini",
+                    help=f"comma-separated, from: {', '.join(ENGINES)}")
+    ap.add_argument("--time", type=int, default=10, help="budget per run (s)")
+    ap.add_argument("--trials", type=int, default=3)
+    ap.add_argument("--threads", type=int, default=0,
+                    help="parallel / portfolio engines; 0 = all cores")
+    ap.add_argument("--pattern", default="*.col")
+    ap.add_argument("--relabel", default="none",
+                    help=f"comma-separated vertex orders to compare, from: {', '.join(RELABEL)}")
+    ap.add_argument("--perf", action="store_true",
+                    help="record L1 / LLC miss rates with perf stat (Linux)")
+    ap.add_argument("--json", help="write results (usable as a later --baseline)")
+    ap.add_argument("--csv", help="write results as CSV")
+    ap.add_argument("--baseline", help="results JSON to check for regressions")
+    ap.add_argument("--tolerance", type=float, default=0.10,
+                    help="relative slack on nodes/s and t_opt (default 0.10)")
+    a = ap.parse_args(argv)
+
+    engines = [e.strip() for e in a.engines.split(",") if e.strip()]
+    bad = [e for e in engines if e not in ENGINES]
+    if bad:
+        ap.error(f"unknown engine(s): {', '.join(bad)}")
+    relabels = [m.strip() for m in a.relabel.split(",") if m.strip()]
+    bad = [m for m in relabels if m not in RELABEL]
+    if bad:
+        ap.error(f"unknown relabel mode(s): {', '.join(bad)}")
+
+    rows = run_suite(a.suite, engines, a.time, a.trials, a.threads, a.pattern, _log_row,
+                     relabels, a.perf)
+    meta = {"suite": os.path.abspath(a.suite), "time": a.time, "trials": a.trials,
+            "threads": a.threads, "engines": engines, "relabel": relabels, "perf": a.perf}
+    if a.json:
+        write_json(a.json, rows, meta)
+    if a.csv:
+        write_csv(a.csv, rows)
+
+    if a.baseline:
+        with open(a.baseline, encoding="utf-8") as f:
+            regressions = compare(rows, json.load(f)["results"], a.tolerance)
+        for msg in regressions:
+            print(f"REGRESSION  {msg}", file=sys.stderr)
+        if regressions:
+            return 1
+        print("no regressions against", a.baseline)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
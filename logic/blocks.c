@@ -0,0 +1,440 @@
+/*
+ * blocks.c
+ * ────────
+ * Biconnected blocks (iterative Hopcroft-Tarjan) and the block-parallel
+ * solve driver (see blocks.h).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "heuristics.h"
+#include "parallel.h"
+#include "blocks.h"
+
+/* ── Blocks ─────────────────────────────────────────────────────────── */
+int blocks_build(int n, const int* adj, const int* start, const int* deg, Blocks* b) {
+    memset(b, 0, sizeof(*b));
+
+    /* Σ|blocks| ≤ n + (number of blocks − 1) ≤ 2n, blocks ≤ n */
+    int* disc   = (int*)malloc((n + 1) * sizeof(int));
+    int* low    = (int*)malloc((n + 1) * sizeof(int));
+    int* parent = (int*)malloc((n + 1) * sizeof(int));
+    int* it     = (int*)malloc((n + 1) * sizeof(int));
+    int* cs     = (int*)malloc((n + 1) * sizeof(int));     /* DFS path   */
+    int* vs     = (int*)malloc((n + 1) * sizeof(int));     /* open verts */
+    int* verts  = (int*)malloc((2 * n + 1) * sizeof(int));
+    int* bstart = (int*)malloc((n + 2) * sizeof(int));
+    int* root   = (int*)malloc((n + 1) * sizeof(int));
+    int ok = disc && low && parent && it && cs && vs && verts && bstart && root;
+
+    int nb = 0, nv = 0, t = 0;
+    if (ok) {
+        for (int v = 0; v < n; v++) disc[v] = -1;
+        for (int s = 0; s < n; s++) {
+            if (disc[s] >= 0) continue;
+            disc[s] = low[s] = t++;
+            parent[s] = -1; it[s] = start[s];
+            int csp = 0, vsp = 0;
+            cs[csp++] = s;
+            vs[vsp++] = s;
+            if (deg[s] == 0) {
+                root[nb] = s; bstart[nb++] = nv; verts[nv++] = s;
+                continue;
+            }
+            while (csp > 0) {
+                int u = cs[csp - 1];
+                if (it[u] < start[u] + deg[u]) {
+                    int w = adj[it[u]++];
+                    if (disc[w] < 0) {
+                        parent[w] = u; disc[w] = low[w] = t++;
+                        it[w] = start[w];
+                        cs[csp++] = w;
+                        vs[vsp++] = w;
+                    } else if (w != parent[u] && disc[w] < low[u]) {
+                        low[u] = disc[w];
+                    }
+                    continue;
+                }
+                csp--;
+                int p = parent[u];
+                if (p < 0) continue;
+                if (low[u] < low[p]) low[p] = low[u];
+                if (low[u] >= disc[p]) {
+                    /* u's subtree above p closes a block rooted at p */
+                    root[nb] = p; bstart[nb++] = nv;
+                    int x;
+                    do { x = vs[--vsp]; verts[nv++] = x; } while (x != u);
+                    verts[nv++] = p;
+                }
+            }
+        }
+        bstart[nb] = nv;
+    }
+    free(disc); free(low); free(parent); free(it); free(cs); free(vs);
+    if (!ok) { free(verts); free(bstart); free(root); return 0; }
+
+    /* Emitted children first: reverse into parents-first order, each
+       block sorted so its induced CSR rows stay sorted. One bucket pass
+       over the vertices sorts every block at once: vertex v lists the
+       blocks holding it, then is appended to each of them in turn. */
+    int* rverts  = (int*)malloc((nv + 1) * sizeof(int));
+    int* rbstart = (int*)malloc((nb + 1) * sizeof(int));
+    int* rroot   = (int*)malloc((nb + 1) * sizeof(int));
+    int* vfirst  = (int*)calloc(n + 1, sizeof(int));
+    int* occ     = (int*)malloc((nv + 1) * sizeof(int));
+    int* fill    = (int*)malloc((nb + 1) * sizeof(int));
+    if (!rverts || !rbstart || !rroot || !vfirst || !occ || !fill) {
+        free(rverts); free(rbstart); free(rroot); free(vfirst); free(occ); free(fill);
+        free(verts); free(bstart); free(root);
+        return 0;
+    }
+    int pos = 0;
+    for (int i = 0; i < nb; i++) {
+        int src = nb - 1 - i;
+        rbstart[i] = pos;
+        rroot[i]   = root[src];
+        pos += bstart[src + 1] - bstart[src];
+    }
+    rbstart[nb] = pos;
+    for (int p = 0; p < nv; p++) vfirst[verts[p] + 1]++;
+    for (int v = 0; v < n; v++) vfirst[v + 1] += vfirst[v];
+    for (int src = 0; src < nb; src++)
+        for (int p = bstart[src]; p < bstart[src + 1]; p++)
+            occ[vfirst[verts[p]]++] = nb - 1 - src;
+    /* vfirst[v] now ends v's run, which starts where v - 1's ended */
+    memcpy(fill, rbstart, nb * sizeof(int));
+    for (int v = 0, p = 0; v < n; v++)
+        for (; p < vfirst[v]; p++) rverts[fill[occ[p]]++] = v;
+    free(vfirst); free(occ); free(fill);
+    free(verts); free(bstart); free(root);
+
+    b->nblocks = nb;
+    b->bstart  = rbstart;
+    b->verts   = rverts;
+    b->root    = rroot;
+    return 1;
+}
+
+void blocks_free(Blocks* b) {
+    free(b->bstart); free(b->verts); free(b->root);
+    memset(b, 0, sizeof(*b));
+}
+
+/* ── Block-parallel solve ───────────────────────────────────────────── */
+#define BLOCKS_POOL_MAX  64
+
+typedef struct {
+    int   n;
+    int*  adj;
+    int*  start;
+    int*  deg;
+    int*  warm;         /* warm colouring restricted to the block       */
+    int*  color;
+
+    int   K, LB, UB_init, timeout, backend;
+    int   status;       /* BB_ERR_COLORS once core() returned it        */
+    long  nodes, cuts;
+} Unit;
+
+typedef struct {
+    BBSolveFn     core;
+    Unit*         units;
+    int*          order;        /* unit indices, largest first          */
+    int           nunits;
+    int           next;         /* atomic: next order[] slot to take    */
+    int           LB;           /* atomic: best proven bound on χ(G)    */
+    int           left;         /* atomic: vertices of searched blocks  */
+                                /*   no thread has taken yet            */
+    int           pool;         /* threads in the pool                  */
+    int           threads;      /* per unit                             */
+    int           temps_max;
+    double        t0;
+    const int*    cancel;       /* caller's token, or NULL              */
+    int           warm_UB;      /* > 0: units carry the caller's warm   */
+                                /*   colouring                          */
+    int           backjump;     /* BBStart fields passed to every unit  */
+    long*         out_jumps;
+    long*         out_nogood_cuts;
+    ProgressRing* progress;
+} Job;
+
+typedef struct {
+    Job* job;
+    int  id;
+} PoolArg;
+
+static void raise_LB(Job* j, int lb) {
+    int cur = __atomic_load_n(&j->LB, __ATOMIC_RELAXED);
+    while (lb > cur &&
+           !__atomic_compare_exchange_n(&j->LB, &cur, lb, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+}
+
+/* Whole seconds nearest to t (≥ 0): truncating would drop up to a
+   second of the caller's budget at every block */
+static int budget_secs(double t) {
+    return t > 0.0 ? (int)(t + 0.5) : 0;
+}
+
+/* core() on u with budget seconds; warm (may be NULL) has colours < warm_UB */
+static void run_unit(Job* j, Unit* u, int budget, int threads, ProgressRing* progress,
+                     const int* warm, int warm_UB) {
+    BBStart ux;
+    memset(&ux, 0, sizeof(ux));
+    ux.known_LB  = __atomic_load_n(&j->LB, __ATOMIC_ACQUIRE);
+    ux.shared_LB = &j->LB;
+    if (warm) { ux.warm_UB = warm_UB; ux.warm_coloring = warm; }
+    ux.backjump        = j->backjump;
+    ux.out_jumps       = j->out_jumps;
+    ux.out_nogood_cuts = j->out_nogood_cuts;
+    ux.cancel          = j->cancel;
+
+    int opt, ub_init, searched = 0;
+    ux.out_searched    = &searched;
+    long nodes, cuts;
+    double t;
+    int st = j->core(u->n, u->adj, u->start, u->deg, budget, progress, &u->K, u->color,
+                     &u->LB, &ub_init, &opt, &nodes, &cuts, &t, &u->timeout,
+                     &u->backend, threads, &ux);
+    if (st < 0) u->status = st;
+    if (!u->UB_init) u->UB_init = ub_init;
+    u->nodes += nodes;
+    u->cuts  += cuts;
+
+    /* A block searched to the end has K = χ(block), or K within the
+       shared LB; a heuristic K (bb_init failed) proves nothing */
+    int proven = st > 0 && searched && !u->timeout;
+    raise_LB(j, !proven || u->LB > u->K ? u->LB : u->K);
+}
+
+static void solve_unit(Job* j, Unit* u, ProgressRing* progress) {
+    if (u->n <= 2) {
+        /* A bridge or an isolated vertex: nothing to search */
+        for (int i = 0; i < u->n; i++) u->color[i] = i;
+        u->K = u->LB = u->UB_init = u->n;
+        raise_LB(j, u->n);
+        return;
+    }
+
+    /* Budget: the block's share, by size, of what is left of the whole
+       solve across the pool, so one hard block cannot starve the rest;
+       rerun_timed_out() hands out what the others leave unused.
+       A cancel issued since the solve started still applies here. */
+    int    left   = __atomic_fetch_sub(&j->left, u->n, __ATOMIC_RELAXED);
+    double rem    = j->temps_max - (now_s() - j->t0);
+    double share  = left > 0 ? rem * u->n * j->pool / left : rem;
+    int    budget = budget_secs(share);
+    int cancelled = bb_cancelled(j->cancel);
+    if (budget > budget_secs(rem)) budget = budget_secs(rem);
+    if (cancelled) budget = 0;
+
+    run_unit(j, u, budget, j->threads, progress, j->warm_UB > 0 ? u->warm : NULL, j->warm_UB);
+    if (cancelled) u->timeout = 1;
+}
+
+/* ── Second pass: blocks cut off by their share, on all threads ───────
+ * Time their siblings left unused goes to the blocks that timed out and
+ * still exceed the shared LB, largest first, each warm-started from its
+ * own colouring with its share by size of what is left. Repeats until
+ * the caller's budget is spent or no such block remains.
+ * ─────────────────────────────────────────────────────────────────── */
+static void rerun_timed_out(Job* j, int n_threads) {
+    for (int i = 0, ran = 0; ; i++) {
+        if (i == j->nunits) {
+            if (!ran) return;
+            i = ran = 0;
+        }
+        if (bb_cancelled(j->cancel)) return;
+        double rem = j->temps_max - (now_s() - j->t0);
+        if (budget_secs(rem) < 1) return;
+
+        int lb = __atomic_load_n(&j->LB, __ATOMIC_ACQUIRE), pending = 0;
+        for (int q = i; q < j->nunits; q++) {
+            const Unit* w = &j->units[j->order[q]];
+            if (w->timeout && w->K > lb) pending += w->n;
+        }
+        Unit* u = &j->units[j->order[i]];
+        if (!u->timeout || u->K <= lb) continue;
+
+        int budget = budget_secs(rem * u->n / pending);
+        if (budget < 1) budget = 1;
+        memcpy(u->warm, u->color, u->n * sizeof(int));
+        run_unit(j, u, budget, n_threads, j->progress, u->warm, u->K);
+        ran = 1;
+    }
+}
+
+static BB_THREAD_RET pool_main(void* arg) {
+    PoolArg* a = (PoolArg*)arg;
+    Job*     j = a->job;
+    ProgressRing* ring = a->id == 0 ? j->progress : NULL;
+#ifdef BB_STATS
+    /* The other threads count into rings of their own, added up below */
+    if (!ring && j->progress) ring = progress_ring_new();
+#endif
+    for (;;) {
+        int i = __atomic_fetch_add(&j->next, 1, __ATOMIC_RELAXED);
+        if (i >= j->nunits) break;
+        solve_unit(j, &j->units[j->order[i]], ring);
+    }
+#ifdef BB_STATS
+    if (ring && ring != j->progress) {
+        bb_stats_add(&j->progress->stats, &ring->stats);
+        progress_ring_free(ring);
+    }
+#endif
+    BB_THREAD_RETURN;
+}
+
+/* Induced CSR of block b; loc[] maps the block's vertices to 0..len-1 */
+static int unit_build(Unit* u, const Blocks* b, int bi, const int* adj, const int* start,
+                      const int* deg, int* loc, int* mark, const int* warm) {
+    const int* vs = b->verts + b->bstart[bi];
+    int len = b->bstart[bi + 1] - b->bstart[bi];
+    for (int i = 0; i < len; i++) { loc[vs[i]] = i; mark[vs[i]] = bi + 1; }
+
+    long entries = 0;
+    u->n     = len;
+    u->start = (int*)malloc((len + 1) * sizeof(int));
+    u->deg   = (int*)malloc((len + 1) * sizeof(int));
+    u->color = (int*)malloc((len + 1) * sizeof(int));
+    u->warm  = (int*)malloc((len + 1) * sizeof(int));     /* also rerun_timed_out() */
+    if (!u->start || !u->deg || !u->color || !u->warm) return 0;
+    for (int i = 0; i < len; i++) {
+        int v = vs[i], d = 0;
+        for (int j = start[v]; j < start[v] + deg[v]; j++) d += mark[adj[j]] == bi + 1;
+        u->start[i] = (int)entries;
+        u->deg[i]   = d;
+        entries    += d;
+        if (warm) u->warm[i] = warm[v];
+    }
+    u->adj = (int*)malloc((entries + 1) * sizeof(int));
+    if (!u->adj) return 0;
+    for (int i = 0; i < len; i++) {
+        int v = vs[i], p = u->start[i];
+        for (int j = start[v]; j < start[v] + deg[v]; j++)
+            if (mark[adj[j]] == bi + 1) u->adj[p++] = loc[adj[j]];
+    }
+    return 1;
+}
+
+int blocks_solve(BBSolveFn core, const Blocks* b,
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x) {
+    double t0 = now_s();
+    int    nb = b->nblocks;
+    int    ret = 1;
+
+    Job j;
+    memset(&j, 0, sizeof(j));
+    j.core = core; j.nunits = nb; j.LB = x->known_LB;
+    j.temps_max = temps_max; j.t0 = t0; j.cancel = x->cancel;
+    j.warm_UB = x->warm_coloring ? x->warm_UB : 0; j.progress = progress;
+    j.backjump = x->backjump;
+    j.out_jumps = x->out_jumps; j.out_nogood_cuts = x->out_nogood_cuts;
+    j.units = (Unit*)calloc(nb, sizeof(Unit));
+    j.order = (int*)malloc(nb * sizeof(int));
+    int* loc  = (int*)malloc((n + 1) * sizeof(int));
+    int* mark = (int*)calloc(n + 1, sizeof(int));
+    int ok = j.units && j.order && loc && mark;
+    for (int i = 0; ok && i < nb; i++)
+        ok = unit_build(&j.units[i], b, i, adj, start, deg, loc, mark, x->warm_coloring);
+
+    if (ok) {
+        /* Largest first: the block that decides χ starts earliest, and
+           its bound then lets the small ones stop at DSATUR */
+        int max_len = 0;
+        for (int i = 0; i < nb; i++) if (j.units[i].n > max_len) max_len = j.units[i].n;
+        int* sizes   = (int*)malloc(nb * sizeof(int));
+        int* scratch = (int*)malloc(CSORT_SCRATCH(nb, max_len) * sizeof(int));
+        ok = sizes && scratch;
+        if (ok) {
+            for (int i = 0; i < nb; i++) { j.order[i] = i; sizes[i] = j.units[i].n; }
+            csort_desc(j.order, nb, sizes, max_len, scratch);
+        }
+        free(sizes); free(scratch);
+    }
+
+    if (ok) {
+        int searched = 0;
+        for (int i = 0; i < nb; i++) {
+            searched += j.units[i].n > 2;
+            if (j.units[i].n > 2) j.left += j.units[i].n;
+        }
+        int pool = n_threads < searched ? n_threads : searched;
+        if (pool < 1) pool = 1;
+        if (pool > BLOCKS_POOL_MAX) pool = BLOCKS_POOL_MAX;
+        j.pool    = pool;
+        j.threads = n_threads / pool > 1 ? n_threads / pool : 1;
+
+        bb_thread_t th[BLOCKS_POOL_MAX];
+        PoolArg     args[BLOCKS_POOL_MAX];
+        int         started[BLOCKS_POOL_MAX];
+        for (int i = 1; i < pool; i++) {
+            args[i].job = &j; args[i].id = i;
+            started[i] = bb_thread_start(&th[i], pool_main, &args[i]);
+        }
+        args[0].job = &j; args[0].id = 0;
+        pool_main(&args[0]);
+        for (int i = 1; i < pool; i++) if (started[i]) bb_thread_join(th[i]);
+        rerun_timed_out(&j, n_threads);
+
+        /* Glue, parents first: permute each block's colours so its root
+           matches the colour it already has */
+        for (int v = 0; v < n; v++) out_coloring[v] = -1;
+        int K = 0, UBi = 0, timeout = 0, back = ADJ_CSR, err = 0;
+        long nodes = 0, cuts = 0;
+        for (int bi = 0; bi < nb; bi++) {
+            const Unit* u  = &j.units[bi];
+            const int*  vs = b->verts + b->bstart[bi];
+            int r = b->root[bi], from = -1, to = -1;
+            if (out_coloring[r] >= 0) {
+                for (int i = 0; i < u->n; i++) if (vs[i] == r) from = u->color[i];
+                to = out_coloring[r];
+            }
+            for (int i = 0; i < u->n; i++) {
+                int c = u->color[i];
+                if (c == from) c = to; else if (c == to) c = from;
+                if (out_coloring[vs[i]] < 0) out_coloring[vs[i]] = c;
+            }
+            if (u->UB_init > UBi) UBi = u->UB_init;
+            nodes   += u->nodes;
+            cuts    += u->cuts;
+            timeout |= u->timeout;
+            err     |= u->status < 0;
+        }
+        for (int v = 0; v < n; v++) if (out_coloring[v] + 1 > K) K = out_coloring[v] + 1;
+        back = j.units[j.order[0]].backend;
+
+        /* χ(G) = max over blocks: K is proven once it meets the LB */
+        int LB = j.LB;
+        *out_K       = K;
+        *out_LB      = LB;
+        *out_UB_init = UBi > LB ? UBi : LB;
+        *out_optimal = K <= LB;
+        *out_nodes   = nodes;
+        *out_cuts    = cuts;
+        *out_time    = now_s() - t0;
+        *out_timeout = K > LB && timeout;
+        *out_backend = back;
+        if (x->out_winner) *x->out_winner = -1;
+        if (err && K > LB) ret = BB_ERR_COLORS;
+    }
+
+    for (int i = 0; j.units && i < nb; i++) {
+        Unit* u = &j.units[i];
+        free(u->adj); free(u->start); free(u->deg); free(u->warm); free(u->color);
+    }
+    free(j.units); free(j.order); free(loc); free(mark);
+    if (!ok)
+        return core(n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                    out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                    out_time, out_timeout, out_backend, n_threads, x);
+    return ret;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#ifndef BLOCKS_H
+#define BLOCKS_H
+
+/*
+ * blocks.h
+ * ────────
+ * Biconnected-block decomposition for the solve front end. χ(G) is the
+ * max of χ over the blocks (the components' blocks included), and block
+ * colourings glue along the block-cut tree. Each block's colours are
+ * permuted so its cut vertex agrees with the block above it, which
+ * leaves every block proper. Blocks are solved independently, so the
+ * B&B no longer multiplies the search spaces of unrelated parts.
+ */
+
+#include "coloring.h"
+#include "reduce.h"
+
+typedef struct {
+    int  nblocks;
+    int* bstart;        /* block b = verts[bstart[b] .. bstart[b+1])    */
+    int* verts;         /*   sorted by vertex index                     */
+    int* root;          /* cut vertex to the parent block, or the DFS   */
+                        /*   root; blocks are stored parents first      */
+} Blocks;
+
+/* ── Blocks of G; an isolated vertex is a block of its own ─────────────
+ * Returns 0 on allocation failure.
+ * ─────────────────────────────────────────────────────────────────── */
+int  blocks_build(int n, const int* adj, const int* start, const int* deg, Blocks* b);
+void blocks_free(Blocks* b);
+
+/* ── core() on every block of G, largest first, glued into a colouring
+ * Same contract as core. Blocks run concurrently only when n_threads >
+ * 1, on a pool of up to n_threads threads; with one thread they run in
+ * turn. Each block gets an equal share of the threads and a share of
+ * what is left of temps_max by its size. Blocks cut off at their share
+ * then get the time the others left unused, on all threads, until
+ * temps_max is spent. A block that finishes raises a shared LB to its χ.
+ * Blocks still running poll it, so any block already coloured within
+ * it stops at once. Progress records come from the first pool thread.
+ * Returns BB_ERR_COLORS when a block's search could not run and K is
+ * not proven, else 1.
+ * ─────────────────────────────────────────────────────────────────── */
+int blocks_solve(BBSolveFn core, const Blocks* b,
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x);
+
+#endif
@@ -0,0 +1,89 @@
+"""
+logic/cache.py
+──────────────
+Persistent cache of the best known result per graph, keyed by the C
+graph_fingerprint() of its CSR, so re-solving an instance starts from
+its best colouring and proven lower bound instead of from scratch.
+
+One JSON file per graph under $GCBB_CACHE_DIR (default
+~/.cache/graph-coloring-bb):
+
+    {"n": …, "K": best colour count, "coloriage": […],
+     "LB": proven lower bound, "optimal": K == χ(G) proven}
+"""
+
+import json
+import os
+import tempfile
+
+from logic.solver import CancelToken, graph_fingerprint, solve_warm
+
+
+def cache_dir() -> str:
+    return os.environ.get("GCBB_CACHE_DIR",
+                          os.path.join(os.path.expanduser("~"), ".cache",
+                                       "graph-coloring-bb"))
+
+
+def _path(fp: str) -> str:
+    return os.path.join(cache_dir(), f"{fp}.json")
+
+
+def lookup(graph_data: dict, fp: str | None = None) -> dict | None:
+    """Cached entry for this graph, or None."""
+    fp = fp or graph_fingerprint(graph_data)
+    try:
+        with open(_path(fp), encoding="utf-8") as f:
+            entry = json.load(f)
+    except (OSError, ValueError):
+        return None
+    if entry.get("n") != graph_data["n"] or len(entry.get("coloriage", ())) != graph_data["n"]:
+        return None
+    return entry
+
+
+def record(graph_data: dict, res: dict, fp: str | None = None) -> dict:
+    """
+    Merge a solver result into the cache: keep the smaller colouring and
+    the larger lower bound. A non-timed-out B&B run that explored its
+    tree proves its K optimal, so K also becomes the lower bound.
+    """
+    fp = fp or graph_fingerprint(graph_data)
+    old = lookup(graph_data, fp)
+
+    lb = res["LB"]
+    if res["optimal"] or (not res["timeout"] and res["noeuds"] > 0):
+        lb = max(lb, res["K"])
+
+    entry = {"n": graph_data["n"], "K": res["K"],
+             "coloriage": [int(c) for c in res["coloriage"]], "LB": lb}
+    if old is not None:
+        if old["K"] <= entry["K"]:
+            entry["K"], entry["coloriage"] = old["K"], old["coloriage"]
+        entry["LB"] = max(entry["LB"], old["LB"])
+    entry["optimal"] = entry["LB"] >= entry["K"]
+
+    os.makedirs(cache_dir(), exist_ok=True)
+    fd, tmp = tempfile.mkstemp(dir=cache_dir(), suffix=".tmp")
+    with os.fdopen(fd, "w", encoding="utf-8") as f:
+        json.dump(entry, f)
+    os.replace(tmp, _path(fp))
+    return entry
+
+
+def solve_cached(algo: str, graph_data: dict, temps_max: int,
+                 live_state: dict | None = None,
+                 cancel_token: CancelToken | None = None) -> dict:
+    """
+    solve_warm() from the cached colouring and LB, then record the result.
+    A graph whose optimum is already proven returns without searching.
+    """
+    fp = graph_fingerprint(graph_data)
+    entry = lookup(graph_data, fp)
+    res = solve_warm(algo, graph_data, temps_max,
+                     warm_coloring=entry["coloriage"] if entry else None,
+                     known_LB=entry["LB"] if entry else 0,
+                     live_state=live_state, cancel_token=cancel_token)
+    res["cached"] = entry is not None
+    record(graph_data, res, fp)
+    return res
@@ -0,0 +1,139 @@
+/*
+ * checkpoint.c
+ * ────────────
+ * Binary checkpoints of stopped B&B runs (see checkpoint.h).
+ */
+
+#include "coloring.h"
+#include "checkpoint.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CKPT_MAGIC    0x4B434242u      /* "BBCK" */
+#define CKPT_VERSION  2u
+
+/* magic, version, engine, n, LB, UB, ub_init, sp: int32
+   graph fingerprint, nodes, cuts: int64 · elapsed: double          */
+#define CKPT_HEADER   (8 * 4 + 4 * 8)
+#define CKPT_FRAME    (5 * 4)
+
+/* ── Field I/O through memcpy (no alignment assumptions on buf) ───── */
+static unsigned char* put32(unsigned char* p, uint32_t x) { memcpy(p, &x, 4); return p + 4; }
+static unsigned char* put64(unsigned char* p, int64_t x)  { memcpy(p, &x, 8); return p + 8; }
+static unsigned char* putf(unsigned char* p, double x)    { memcpy(p, &x, 8); return p + 8; }
+
+static const unsigned char* get32(const unsigned char* p, uint32_t* x) { memcpy(x, p, 4); return p + 4; }
+static const unsigned char* get64(const unsigned char* p, int64_t* x)  { memcpy(x, p, 8); return p + 8; }
+static const unsigned char* getf(const unsigned char* p, double* x)    { memcpy(x, p, 8); return p + 8; }
+
+EXPORT int bb_checkpoint_bytes(int n) {
+    return CKPT_HEADER + 4 * n + CKPT_FRAME * n;
+}
+
+int ckpt_write(const BBState* s, int engine, int ub_init, double elapsed,
+               unsigned char* buf) {
+    unsigned char* p = buf;
+    p = put32(p, CKPT_MAGIC);
+    p = put32(p, CKPT_VERSION);
+    p = put32(p, (uint32_t)engine);
+    p = put32(p, (uint32_t)s->n);
+    p = put32(p, (uint32_t)s->LB);
+    p = put32(p, (uint32_t)s->UB);
+    p = put32(p, (uint32_t)ub_init);
+    p = put32(p, (uint32_t)s->sp);
+    p = put64(p, (int64_t)graph_fingerprint(s->n, s->adj, s->start, s->deg));
+    p = put64(p, (int64_t)s->nodes_visited);
+    p = put64(p, (int64_t)s->branches_cut);
+    p = putf(p, elapsed);
+
+    for (int v = 0; v < s->n; v++) p = put32(p, (uint32_t)s->best_color[v]);
+    for (int i = 0; i < s->sp; i++) {
+        const BBFrame* f = &s->stack[i];
+        p = put32(p, (uint32_t)f->v);
+        p = put32(p, (uint32_t)f->c);
+        p = put32(p, (uint32_t)f->k);
+        p = put32(p, (uint32_t)f->c_limit);
+        p = put32(p, (uint32_t)f->tried);
+    }
+    return (int)(p - buf);
+}
+
+int ckpt_read(const unsigned char* buf, int len, int engine,
+              int n, const int* adj, const int* start, const int* deg,
+              CkptInfo* info) {
+    if (!buf || len < CKPT_HEADER) return 0;
+
+    uint32_t magic, version, eng, cn, lb, ub, ubi, sp;
+    int64_t  hash, nodes, cuts;
+    const unsigned char* p = buf;
+    p = get32(p, &magic); p = get32(p, &version); p = get32(p, &eng);
+    p = get32(p, &cn);
+    p = get32(p, &lb);    p = get32(p, &ub);      p = get32(p, &ubi);
+    p = get32(p, &sp);
+    p = get64(p, &hash);
+    p = get64(p, &nodes); p = get64(p, &cuts);    p = getf(p, &info->elapsed);
+
+    if (magic != CKPT_MAGIC || version != CKPT_VERSION) return 0;
+    if ((int)eng != engine || (int)cn != n) return 0;
+    if ((int)sp < 0 || (int)sp > n) return 0;
+    if (len != CKPT_HEADER + 4 * n + CKPT_FRAME * (int)sp) return 0;
+    if ((uint64_t)hash != graph_fingerprint(n, adj, start, deg)) return 0;
+
+    info->engine  = (int)eng;
+    info->LB      = (int)lb;
+    info->UB      = (int)ub;
+    info->ub_init = (int)ubi;
+    info->sp      = (int)sp;
+    info->nodes   = (long)nodes;
+    info->cuts    = (long)cuts;
+    if (info->LB < 0 || info->LB > info->UB || info->UB > info->ub_init) return 0;
+
+    int* col = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!col) return 0;
+
+    /* Incumbent: a proper colouring with colours below UB */
+    int ok = 1;
+    for (int v = 0; v < n; v++) {
+        uint32_t c; p = get32(p, &c);
+        col[v] = (int)c;
+        if ((int)c < 0 || (int)c >= info->UB) ok = 0;
+    }
+    for (int v = 0; v < n && ok; v++)
+        for (int j = start[v]; ok && j < start[v] + deg[v]; j++)
+            ok = col[adj[j]] != col[v];
+
+    /* Path: distinct vertices, colours inside their frame's range and
+       unused by the neighbours coloured earlier on it */
+    for (int v = 0; v < n; v++) col[v] = -1;
+    for (int i = 0; i < info->sp && ok; i++) {
+        uint32_t v, c, k, cl, tried;
+        p = get32(p, &v); p = get32(p, &c); p = get32(p, &k);
+        p = get32(p, &cl); p = get32(p, &tried);
+        ok = (int)v >= 0 && (int)v < n && col[v] < 0
+          && (int)cl <= info->ub_init && (int)k <= info->ub_init
+          && (int)c >= 0 && (int)c < (int)cl;
+        if (ok) {
+            for (int j = start[v]; ok && j < start[v] + deg[v]; j++)
+                ok = col[adj[j]] != (int)c;
+            if (ok) col[v] = (int)c;
+        }
+    }
+    free(col);
+    return ok;
+}
+
+void ckpt_load(const unsigned char* buf, const CkptInfo* info,
+               BBState* s, int* best_color) {
+    uint32_t x;
+    const unsigned char* p = buf + CKPT_HEADER;
+    s->sp = info->sp;
+    for (int v = 0; v < s->n; v++) { p = get32(p, &x); best_color[v] = (int)x; }
+    for (int i = 0; i < s->sp; i++) {
+        BBFrame* f = &s->stack[i];
+        p = get32(p, &x); f->v       = (int)x;
+        p = get32(p, &x); f->c       = (int)x;
+        p = get32(p, &x); f->k       = (int)x;
+        p = get32(p, &x); f->c_limit = (int)x;
+        p = get32(p, &x); f->tried   = (int)x;
+    }
+}
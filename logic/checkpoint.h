@@ -0,0 +1,64 @@
+#pragma once
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+/*
+ * checkpoint.h
+ * ────────────
+ * Compact binary snapshot of a sequential B&B run stopped by its time
+ * limit: bounds, counters, incumbent colouring and the DFS path left in
+ * BBState.stack. Resuming replays the path and re-enters the node the
+ * search stopped at, so neither the greedy_clique / DSATUR start-up nor
+ * any finished subtree is run again.
+ *
+ * Layout (native-endian): fixed header, best colouring int32[n], then
+ * sp frames of five int32 (v, c, k, c_limit, tried). The header carries
+ * graph_fingerprint() and the engine id so a checkpoint is only
+ * accepted by the engine and graph that wrote it.
+ */
+
+#include "coloring.h"
+
+#define CKPT_SEWELL  0
+#define CKPT_FURINI  1
+
+/* Header fields, read back by ckpt_read() before bb_init() */
+typedef struct {
+    int    engine;
+    int    LB;
+    int    UB;
+    int    ub_init;
+    int    sp;
+    long   nodes;
+    long   cuts;
+    double elapsed;     /* seconds spent in all previous runs          */
+} CkptInfo;
+
+/* ── Largest checkpoint an n-vertex run can produce (bytes) ────────── */
+EXPORT int bb_checkpoint_bytes(int n);
+
+/* ── Serialise stopped state s; returns bytes written to buf ───────────
+ * buf must hold bb_checkpoint_bytes(s->n). s->best_color is the
+ * incumbent, s->stack[0..s->sp-1] the saved path.
+ * ─────────────────────────────────────────────────────────────────── */
+int ckpt_write(const BBState* s, int engine, int ub_init, double elapsed,
+               unsigned char* buf);
+
+/* ── Validate buf against the graph and engine, fill info ──────────────
+ * Returns 0 when the checkpoint is truncated, corrupt, or was written
+ * for another graph or engine. An incumbent that is not a proper
+ * colouring, or a path that gives a vertex the colour of a neighbour
+ * coloured before it, counts as corrupt.
+ * ─────────────────────────────────────────────────────────────────── */
+int ckpt_read(const unsigned char* buf, int len, int engine,
+              int n, const int* adj, const int* start, const int* deg,
+              CkptInfo* info);
+
+/* ── Copy the colouring into best_color and the path into s->stack ────
+ * s must come from bb_init(…, info.ub_init) on the same graph, and buf
+ * must have passed ckpt_read().
+ * ─────────────────────────────────────────────────────────────────── */
+void ckpt_load(const unsigned char* buf, const CkptInfo* info,
+               BBState* s, int* best_color);
+
+#endif
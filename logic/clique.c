@@ -0,0 +1,160 @@
+/*
+ * clique.c
+ * ────────
+ * Exact maximum clique, bit-parallel (BBMC, San Segundo et al. 2011,
+ * on Tomita's MCS colouring bound).
+ *
+ * Every node holds its candidate set P as a bit row. P is greedily
+ * coloured class by class (one AND-NOT per coloured vertex), and a
+ * vertex of colour k can extend the current clique C to at most
+ * |C| + k. Branching runs from the highest colour down and stops at the
+ * first vertex whose bound cannot beat the best clique; vertices whose
+ * colour is already too low are never stored.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "heuristics.h"
+#include "clique.h"
+
+typedef struct {
+    const uint64_t* mat;
+    int    words;
+    int    best;
+    int    target;
+    long   nodes;
+    long   max_nodes;
+    double deadline;
+    const int* cancel;  /* solve's token: a cancel aborts (or NULL)   */
+    int    stop;        /* best reached target, or aborted            */
+    int    aborted;     /* a budget or the arena ran out              */
+    Arena* ws;
+} Mcs;
+
+static void expand(Mcs* m, uint64_t* P, int csize) {
+    m->nodes++;
+    if ((m->max_nodes > 0 && m->nodes > m->max_nodes) ||
+        ((m->nodes & 1023) == 0 && ((m->deadline > 0.0 && now_s() > m->deadline) ||
+                                    bb_cancelled(m->cancel)))) {
+        m->stop = m->aborted = 1;
+        return;
+    }
+
+    int    words = m->words;
+    size_t mark  = m->ws->top;
+    int    np    = bitrow_count(P, words);
+    int*      order = (int*)arena_push(m->ws, np * sizeof(int));
+    int*      bound = (int*)arena_push(m->ws, np * sizeof(int));
+    uint64_t* U     = (uint64_t*)arena_push(m->ws, words * sizeof(uint64_t));
+    uint64_t* Q     = (uint64_t*)arena_push(m->ws, words * sizeof(uint64_t));
+    uint64_t* NP    = (uint64_t*)arena_push(m->ws, words * sizeof(uint64_t));
+    if (!order || !bound || !U || !Q || !NP) {
+        m->stop = m->aborted = 1;
+        m->ws->top = mark;
+        return;
+    }
+
+    /* ── Greedy colour classes of P in vertex order ────────────────────
+     * Colours ≤ kmin cannot lift csize above best: not stored.
+     * ─────────────────────────────────────────────────────────────── */
+    int kmin = m->best - csize;
+    int no = 0, k = 0, w0 = 0;
+    memcpy(U, P, words * sizeof(uint64_t));
+    while (w0 < words) {
+        k++;
+        memcpy(Q + w0, U + w0, (words - w0) * sizeof(uint64_t));
+        for (int w = w0; w < words; w++) {
+            while (Q[w]) {
+                int      b   = __builtin_ctzll(Q[w]);
+                int      v   = (w << 6) + b;
+                uint64_t bit = 1ULL << b;
+                const uint64_t* row = m->mat + (size_t)v * words;
+                Q[w] &= ~bit; U[w] &= ~bit;
+                for (int x = w; x < words; x++) Q[x] &= ~row[x];
+                if (k > kmin) { order[no] = v; bound[no] = k; no++; }
+            }
+        }
+        while (w0 < words && !U[w0]) w0++;
+    }
+
+    /* ── Branch on the highest colours first ── */
+    for (int i = no - 1; i >= 0 && !m->stop; i--) {
+        if (csize + bound[i] <= m->best) break;
+        int v = order[i];
+        const uint64_t* row = m->mat + (size_t)v * words;
+        uint64_t any = 0;
+        for (int w = 0; w < words; w++) any |= (NP[w] = P[w] & row[w]);
+
+        if (any) expand(m, NP, csize + 1);
+        else if (csize + 1 > m->best) m->best = csize + 1;
+
+        P[v >> 6] &= ~(1ULL << (v & 63));
+        if (m->best >= m->target) m->stop = 1;
+    }
+
+    m->ws->top = mark;
+}
+
+int bbmc_clique(int n, const uint64_t* mat, int words, int lb, int target,
+                long max_nodes, double deadline, const int* cancel, Arena* ws,
+                int* out_exact) {
+    if (out_exact) *out_exact = 1;
+    if (n <= 0 || lb >= target) return lb;
+
+    size_t    mark = ws->top;
+    uint64_t* P    = (uint64_t*)arena_push_zero(ws, words * sizeof(uint64_t));
+    if (!P) { if (out_exact) *out_exact = 0; return lb; }
+    for (int v = 0; v < n; v++) P[v >> 6] |= 1ULL << (v & 63);
+
+    Mcs m;
+    memset(&m, 0, sizeof(m));
+    m.mat = mat; m.words = words; m.best = lb; m.target = target;
+    m.max_nodes = max_nodes; m.deadline = deadline; m.ws = ws;
+    m.cancel = cancel;
+    expand(&m, P, 0);
+
+    ws->top = mark;
+    if (out_exact) *out_exact = !m.aborted;
+    return m.best;
+}
+
+EXPORT int max_clique(int n, const int* adj, const int* start, const int* deg,
+                      int lb, int ub, double time_limit, const int* cancel,
+                      int* out_exact) {
+    int exact = 0;
+    if (out_exact) *out_exact = 0;
+    if (n <= 0) { if (out_exact) *out_exact = 1; return 0; }
+    if (ub > n) ub = n;
+    if (lb >= ub) { if (out_exact) *out_exact = 1; return lb; }
+
+    int    words = (n + 63) >> 6;
+    size_t bytes = (size_t)n * words * sizeof(uint64_t);
+    if (bytes > ADJMAT_MAX_BYTES) return lb;
+
+    /* Renumber by degree descending: pos[v] = bit of v */
+    int max_deg = 0;
+    for (int v = 0; v < n; v++) if (deg[v] > max_deg) max_deg = deg[v];
+    int*      order   = (int*)malloc(n * sizeof(int));
+    int*      pos     = (int*)malloc(n * sizeof(int));
+    int*      scratch = (int*)malloc(CSORT_SCRATCH(n, max_deg) * sizeof(int));
+    uint64_t* mat     = (uint64_t*)calloc((size_t)n * words, sizeof(uint64_t));
+    Arena     ws;
+    int ok = order && pos && scratch && mat && arena_init(&ws, bbmc_ws_bytes(n, ub));
+    if (ok) {
+        for (int i = 0; i < n; i++) order[i] = i;
+        csort_desc(order, n, deg, max_deg, scratch);
+        for (int i = 0; i < n; i++) pos[order[i]] = i;
+        for (int u = 0; u < n; u++) {
+            uint64_t* row = mat + (size_t)pos[u] * words;
+            for (int j = start[u]; j < start[u] + deg[u]; j++)
+                row[pos[adj[j]] >> 6] |= 1ULL << (pos[adj[j]] & 63);
+        }
+        double deadline = time_limit > 0.0 ? now_s() + time_limit : 0.0;
+        lb = bbmc_clique(n, mat, words, lb, ub, 0, deadline, cancel, &ws, &exact);
+        arena_free(&ws);
+    }
+    free(order); free(pos); free(scratch); free(mat);
+    if (out_exact) *out_exact = ok && exact;
+    return lb;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef CLIQUE_H
+#define CLIQUE_H
+
+/*
+ * clique.h
+ * ────────
+ * Exact maximum clique by bit-parallel branch and bound (Tomita's MCS
+ * bound, San Segundo's BBMC bitset encoding). Used for the root lower
+ * bound and by Furini's lb_reduced() on small reduced graphs.
+ */
+
+#include "coloring.h"
+
+/* ── Arena bytes bbmc_clique() needs on n vertices, depth ≤ depth ───── */
+static inline size_t bbmc_ws_bytes(int n, int depth) {
+    size_t words = ((size_t)n + 63) >> 6;
+    size_t level = 2 * ARENA_PAD((size_t)n * sizeof(int))
+                 + 3 * ARENA_PAD(words * sizeof(uint64_t));
+    return ARENA_PAD(words * sizeof(uint64_t)) + (size_t)(depth + 1) * level;
+}
+
+/* ── Maximum clique of a bit-matrix graph ──────────────────────────────
+ * mat holds n rows of `words` uint64_t, symmetric and loop-free; vertex
+ * order is the branching order, so callers number vertices by degree
+ * descending. Only cliques larger than lb are searched for, and the
+ * search stops as soon as one reaches target (an upper bound on ω, or
+ * the size the caller needs). max_nodes ≤ 0 / deadline ≤ 0 disable
+ * either budget, and bb_cancel() on cancel (may be NULL) aborts it like
+ * a spent budget. ws must hold bbmc_ws_bytes(n, target) and gets its
+ * mark back on return.
+ *
+ * Returns max(lb, largest clique found). *out_exact (may be NULL) = 1
+ * when no budget ran out, i.e. the result is min(ω, target) or ω ≤ lb.
+ * ─────────────────────────────────────────────────────────────────── */
+int bbmc_clique(int n, const uint64_t* mat, int words, int lb, int target,
+                long max_nodes, double deadline, const int* cancel, Arena* ws,
+                int* out_exact);
+
+/* ── ω(G) from CSR, within time_limit seconds (≤ 0 = no limit) ─────────
+ * lb / ub as for bbmc_clique(): known clique size and upper bound on ω
+ * (e.g. a colouring's size). Skipped (returns lb, not exact) when the
+ * renumbered bit-matrix would exceed ADJMAT_MAX_BYTES.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int max_clique(int n, const int* adj, const int* start, const int* deg,
+                      int lb, int ub, double time_limit, const int* cancel,
+                      int* out_exact);
+
+#endif
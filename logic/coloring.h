@@ -8,6 +8,14 @@
 #include <stdio.h>
 #include <limits.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #include <immintrin.h>
+  #define BITROW_AVX2 1
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
+  #define BITROW_NEON 1
+#endif
+
 #ifdef _WIN32
   #include <windows.h>
   #define EXPORT __declspec(dllexport)
@@ -27,41 +35,344 @@
   }
 #endif
 
-/* ── ColorSet: bitset for up to 63 colors ─────────────────────────────
-   All standard DIMACS benchmarks (DSJC125.x, queen*, etc.) stay under 63.
+/* ── ColorSet: multi-word colour bitsets ──────────────────────────────
+   Each vertex owns a row of W words (colour c = bit c%64 of word c/64).
+   W is 1, 2, 4 or 8 for palettes up to 64 / 128 / 256 / 512 colours,
+   ⌈ncolors/64⌉ beyond. The hot loops are compiled once per fixed W, the
+   cs_* helpers taking W as a constant (CS_INLINE) so W = 1 reduces to
+   plain single-word code; W = s->cwords gives the generic variant.
    ─────────────────────────────────────────────────────────────────── */
 typedef uint64_t ColorSet;
 
-#define CS_ADD(s,c)   ((s) |=  (1ULL << (c)))
-#define CS_HAS(s,c)   (((s)  >> (c)) & 1ULL)
-#define CS_DEL(s,c)   ((s) &= ~(1ULL << (c)))
+#if defined(__GNUC__)
+  #define CS_INLINE static inline __attribute__((always_inline))
+#else
+  #define CS_INLINE static inline
+#endif
+
+#define CS_MAX_FIXED_WORDS 8
+
 #define CS_COUNT(s)   __builtin_popcountll(s)
 #define CS_LOWEST(s)  __builtin_ctzll(s)
 
+/* Row length for a palette of ncolors colours */
+static inline int cs_words(int ncolors) {
+    int w = (ncolors + 63) >> 6;
+    if (w <= 1) return 1;
+    if (w <= 2) return 2;
+    if (w <= 4) return 4;
+    if (w <= CS_MAX_FIXED_WORDS) return CS_MAX_FIXED_WORDS;
+    return w;
+}
+
+CS_INLINE int cs_has(const ColorSet* cs, int c, int W) {
+    if (W == 1) return (int)((cs[0] >> c) & 1ULL);
+    return (int)((cs[c >> 6] >> (c & 63)) & 1ULL);
+}
+
+CS_INLINE void cs_add(ColorSet* cs, int c, int W) {
+    if (W == 1) cs[0] |= 1ULL << c;
+    else        cs[c >> 6] |= 1ULL << (c & 63);
+}
+
+CS_INLINE void cs_del(ColorSet* cs, int c, int W) {
+    if (W == 1) cs[0] &= ~(1ULL << c);
+    else        cs[c >> 6] &= ~(1ULL << (c & 63));
+}
+
+CS_INLINE int cs_count(const ColorSet* cs, int W) {
+    int cnt = 0;
+    for (int i = 0; i < W; i++) cnt += CS_COUNT(cs[i]);
+    return cnt;
+}
+
+/* Colours {0..ub-1} in one word; word i of a row is cs_mask(ub - 64·i) */
 static inline ColorSet cs_mask(int ub) {
     if (ub <= 0)  return 0ULL;
     if (ub >= 64) return ~0ULL;
     return (1ULL << ub) - 1ULL;
 }
 
-/* ── Progress callback (fired every 500 B&B nodes) ── */
-typedef void (*ProgressCB)(long nodes, int UB, int LB, double t, long cuts);
+/* |{0..ub-1} \ (a ∪ b)|: colours still open to both rows */
+CS_INLINE int cs_count_free2(const ColorSet* a, const ColorSet* b, int ub, int W) {
+    int cnt = 0;
+    for (int i = 0; i < W; i++) cnt += CS_COUNT(cs_mask(ub - 64 * i) & ~(a[i] | b[i]));
+    return cnt;
+}
+
+/* ── Scratch arena: bump allocation, reset to a saved mark ────────────
+ * Sized once by the solver; per-node bound code pushes its buffers and
+ * pops back to the mark on return, so the steady state never touches
+ * the heap. Blocks are 64-byte aligned.
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    uint8_t* base;
+    size_t   cap;
+    size_t   top;
+} Arena;
+
+#define ARENA_ALIGN 64
+#define ARENA_PAD(b) (((b) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+static inline int arena_init(Arena* a, size_t cap) {
+    a->top = 0;
+    a->cap = ARENA_PAD(cap);
+    a->base = (uint8_t*)malloc(a->cap + ARENA_ALIGN);
+    if (!a->base) { a->cap = 0; return 0; }
+    return 1;
+}
+
+static inline void arena_free(Arena* a) {
+    free(a->base); a->base = NULL; a->cap = a->top = 0;
+}
+
+/* NULL when the block does not fit (caller falls back) */
+static inline void* arena_push(Arena* a, size_t bytes) {
+    size_t need = ARENA_PAD(bytes);
+    if (!a->base || a->top + need > a->cap) return NULL;
+    uint8_t* aligned = (uint8_t*)ARENA_PAD((uintptr_t)a->base);
+    void* p = aligned + a->top;
+    a->top += need;
+    return p;
+}
+
+static inline void* arena_push_zero(Arena* a, size_t bytes) {
+    void* p = arena_push(a, bytes);
+    if (p) memset(p, 0, bytes);
+    return p;
+}
+
+/* ── Zeroed heap block on a cache line; release with aligned_free() ── */
+static inline void* aligned_calloc(size_t bytes) {
+    uint8_t* raw = (uint8_t*)calloc(bytes + ARENA_ALIGN + sizeof(void*), 1);
+    if (!raw) return NULL;
+    uint8_t* p = (uint8_t*)ARENA_PAD((uintptr_t)(raw + sizeof(void*)));
+    ((void**)p)[-1] = raw;
+    return p;
+}
+
+static inline void aligned_free(void* p) {
+    if (p) free(((void**)p)[-1]);
+}
+
+/* ── Search statistics (opt-in: compile with -DBB_STATS) ──────────────
+ * Cycles spent in each hot-path phase, nodes and bound prunes per B&B
+ * depth (vertices coloured), and how many branches each branching node
+ * took. Every BBState counts its own; solve() adds them into the
+ * progress ring of the call (progress_ring_stats() copies them out).
+ * Without BB_STATS neither struct carries the block and the BB_STAT /
+ * BB_TIMED hooks compile to the bare statement.
+ * ─────────────────────────────────────────────────────────────────── */
+#define BB_PH_SELECT    0       /* branching vertex choice             */
+#define BB_PH_BOUND     1       /* per-node lower bound (Furini)       */
+#define BB_PH_COLOR     2       /* colorier() and its bound upkeep     */
+#define BB_PH_UNCOLOR   3       /* decolorier() and its bound upkeep   */
+#define BB_PH_CLOCK     4       /* time-limit / cancel check           */
+#define BB_PHASES       5
+
+#define BB_STATS_DEPTHS 256     /* deeper nodes count in the last slot */
+#define BB_STATS_BRANCH 64      /* idem for branches per node          */
+
+typedef struct {
+    uint64_t cycles[BB_PHASES];
+    uint64_t calls[BB_PHASES];
+    uint64_t max_depth;
+    uint64_t depth_nodes[BB_STATS_DEPTHS];  /* nodes entered             */
+    uint64_t depth_tests[BB_STATS_DEPTHS];  /* inner nodes bound-tested  */
+    uint64_t depth_cuts[BB_STATS_DEPTHS];   /*   … and pruned            */
+    uint64_t branching[BB_STATS_BRANCH];    /* branching nodes by number
+                                               of children              */
+} BBStats;
+
+#ifdef BB_STATS
+/* Raw cycle counter: TSC, the ARM virtual counter, else nanoseconds */
+static inline uint64_t bb_cycles(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    return (uint64_t)(now_s() * 1e9);
+#endif
+}
+
+static inline void bb_stats_add_n(uint64_t* dst, const uint64_t* src, int len) {
+    for (int i = 0; i < len; i++)
+        if (src[i]) __atomic_fetch_add(&dst[i], src[i], __ATOMIC_RELAXED);
+}
+
+/* dst += src; safe against other threads adding into dst */
+static inline void bb_stats_add(BBStats* dst, const BBStats* src) {
+    bb_stats_add_n(dst->cycles, src->cycles, BB_PHASES);
+    bb_stats_add_n(dst->calls, src->calls, BB_PHASES);
+    bb_stats_add_n(dst->depth_nodes, src->depth_nodes, BB_STATS_DEPTHS);
+    bb_stats_add_n(dst->depth_tests, src->depth_tests, BB_STATS_DEPTHS);
+    bb_stats_add_n(dst->depth_cuts, src->depth_cuts, BB_STATS_DEPTHS);
+    bb_stats_add_n(dst->branching, src->branching, BB_STATS_BRANCH);
+    uint64_t cur = __atomic_load_n(&dst->max_depth, __ATOMIC_RELAXED);
+    while (src->max_depth > cur &&
+           !__atomic_compare_exchange_n(&dst->max_depth, &cur, src->max_depth, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+#endif
+
+/* ── Progress ring (written every PROGRESS_EVERY B&B nodes) ──────────
+ * One producer per solve (the sequential engine, or worker 0 of a
+ * parallel / portfolio run) appends fixed-size records without locks or
+ * callbacks; readers poll with progress_ring_read() at their own pace.
+ * A slot's seq is odd while it is written and 2i+2 once record i is in
+ * it, so a reader that gets lapped drops the slot instead of tearing it.
+ * ─────────────────────────────────────────────────────────────────── */
+#define PROGRESS_EVERY     500
+#define PROGRESS_RING_CAP  4096          /* records, power of two      */
+
+typedef struct {
+    uint64_t seq;
+    long     nodes;
+    long     cuts;
+    double   t;             /* seconds since the solve started         */
+    int      UB;
+    int      LB;
+    int      depth;         /* B&B depth of the node that wrote it     */
+    int      pad_;
+} ProgressRec;
+
+typedef struct ProgressRing {
+    uint64_t    head;       /* records ever written                    */
+    ProgressRec rec[PROGRESS_RING_CAP];
+#ifdef BB_STATS
+    BBStats     stats;      /* totals of the solve, written at its end */
+#endif
+} ProgressRing;
+
+EXPORT ProgressRing* progress_ring_new(void);
+EXPORT void          progress_ring_free(ProgressRing* r);
+
+/* ── Statistics of the finished solve that wrote r into *out ──────────
+ * Returns 0 (out untouched) when the library was built without BB_STATS.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int progress_ring_stats(const ProgressRing* r, BBStats* out);
+
+/* ── Copy up to max records from *cursor on into out; returns count ───
+ * *cursor (start at 0) moves past what was read. Records overwritten
+ * before the reader got to them are skipped.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int progress_ring_read(const ProgressRing* r, uint64_t* cursor,
+                              ProgressRec* out, int max);
+
+static inline void progress_push(ProgressRing* r, long nodes, long cuts,
+                                 int UB, int LB, int depth, double t) {
+    uint64_t     i = r->head;
+    ProgressRec* e = &r->rec[i & (PROGRESS_RING_CAP - 1)];
+    __atomic_store_n(&e->seq, 2 * i + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    e->nodes = nodes; e->cuts = cuts; e->t = t;
+    e->UB = UB; e->LB = LB; e->depth = depth;
+    __atomic_store_n(&e->seq, 2 * i + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&r->head, i + 1, __ATOMIC_RELEASE);
+}
 
 /* ── B&B state shared by both algorithms ─────────────────────────────
    Graph pointers are NOT owned by this struct (owned by caller).
    All other arrays ARE allocated/freed by the solver function.
    ─────────────────────────────────────────────────────────────────── */
+struct ParShared;
+
+/* ── Explicit DFS frame: one per branching node on the current path ── */
+typedef struct {
+    int v;          /* vertex branched on                              */
+    int c;          /* colour of v in the subtree being explored       */
+    int k;          /* colours in use at this node                     */
+    int c_limit;    /* branches are colours 0..c_limit-1               */
+    int tried;      /* branches taken or handed off so far             */
+} BBFrame;
+
+/* ── Per-vertex search record ──────────────────────────────────────────
+ * Everything colorier() reads or writes for a vertex, in 16 bytes: a
+ * neighbour visit costs one line here plus its ccnt counter, and the
+ * row bounds of the vertex being coloured come with its state. Colours
+ * and DSAT levels fit 16 bits because ncolors ≤ BB_MAX_COLORS (n ·
+ * ncolors ccnt counters rule out more long before). cset rows stay in
+ * their own array: their width W depends on the palette.
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    int16_t color;      /* current colour; -1 = uncoloured             */
+    int16_t dsat;       /* DSAT saturation degree                      */
+    int32_t rank;       /* position of v in order                      */
+    int32_t start;      /* = start[v]                                  */
+    int32_t deg;        /* = deg[v]                                    */
+} BBVert;
+
+#define BB_MAX_COLORS  INT16_MAX
+
+/* Status of a solve whose start-up colouring needs more than
+   BB_MAX_COLORS colours with LB below it: no B&B ran, the outputs hold
+   the heuristic bounds */
+#define BB_ERR_COLORS  (-1)
+
+/* ── Index layouts: widths of neighbour ids and of ccnt counters ──────
+ * Picked once per state; the hot loops are compiled per layout like
+ * per ColorSet width (L a constant, or s->ix for the generic variant).
+ * A counter never exceeds the degree of its vertex, so 16 bits hold
+ * it unless some degree tops UINT16_MAX.
+ * ─────────────────────────────────────────────────────────────────── */
+#define BB_IX16    0    /* uint16 ids (adj16, n ≤ 65536), uint16 ccnt  */
+#define BB_IX32    1    /* int ids (adj), uint16 ccnt                  */
+#define BB_IX32W   2    /* int ids, int ccnt: some degree > UINT16_MAX */
+
+#define BB_IX16_MAX_N  (UINT16_MAX + 1)
+
 typedef struct {
     /* graph (borrowed) */
-    int   n;
-    int*  adj;    /* flat CSR adjacency, sorted per vertex             */
-    int*  start;  /* start[v] = first index of v's neighbors in adj   */
-    int*  deg;    /* degree[v]                                         */
+    int         n;
+    const int*  adj;    /* flat CSR adjacency, sorted per vertex       */
+    const int*  start;  /* start[v] = first index of v's neighbors     */
+    const int*  deg;    /* degree[v]                                   */
 
-    /* search state (owned) */
-    int*      color;       /* current partial coloring; -1 = uncolored */
-    ColorSet* cset;        /* for each vertex: bitset of adjacent colors */
-    int*      dsat;        /* DSAT saturation degree                    */
+    /* search state (owned, 64-byte aligned) */
+    BBVert*   vert;        /* vert[v]: colour, DSAT, rank, CSR row of v */
+    ColorSet* cset;        /* cset[v*cwords ..]: colors adjacent to v   */
+    int       cwords;      /* words per cset row = cs_words(ncolors)    */
+    int       ncolors;     /* row length of ccnt (colors ≤ ncolors-1)   */
+    void*     ccnt;        /* ccnt[w*ncolors + c] = # colored neighbors
+                              of w holding color c (uncolored w only);
+                              uint16_t, or int under BB_IX32W           */
+    int       ix;          /* index layout, BB_IX*                      */
+    uint16_t* adj16;       /* adj as uint16 ids (owned, see adj16_build)
+                              under BB_IX16, else NULL                  */
+
+    /* DSATUR selection index (owned) ─────────────────────────────────
+       Uncolored vertices are kept in one bitset per DSAT level, indexed
+       by rank in (degree desc, vertex asc) order, so the first set bit
+       of the highest non-empty level is exactly the DSATUR choice.
+       qsumm holds one bit per non-zero qbits word for a fast first-bit. */
+    int*      order;       /* order[r] = vertex of rank r               */
+    int       qwords;      /* qbits words per level  = ⌈n/64⌉           */
+    int       qsw;         /* qsumm words per level  = ⌈qwords/64⌉      */
+    int       qlevels;     /* DSAT levels 0..qlevels-1 (= ncolors + 1)  */
+    uint64_t* qbits;       /* qbits[d*qwords + r/64], bit r%64          */
+    uint64_t* qsumm;       /* qsumm[d*qsw + w/64],    bit w%64          */
+    int*      qcount;      /* qcount[d] = # uncolored vertices at DSAT d */
+    int       qmax;        /* highest non-empty level, -1 if none       */
+
+    /* adjacency bit-matrix (owned, NULL when the CSR backend is used) */
+    uint64_t* amat;        /* amat[u*awords + v/64] bit v%64 ⟺ uv ∈ E   */
+    int       awords;      /* words per matrix row = ⌈n/64⌉             */
+
+    /* DFS path (owned): explore() is iterative over stack[0..n].
+       A stopped search undoes its colouring but leaves the path in
+       stack[0..sp-1]; the next explore() replays it and re-enters the
+       node it stopped at. sp = 0 starts a fresh search.              */
+    BBFrame*  stack;
+    int       sp;
+
+    /* per-node scratch for bound computations (owned) */
+    Arena     ws;
+    void*     bound_state; /* engine's incremental bound data, carved
+                              from ws (bb_furini.c), or NULL           */
 
     /* bounds */
     int   UB;              /* current best upper bound (# colors used)  */
@@ -75,12 +386,97 @@ typedef struct {
     /* time */
     double time_start;
     int    temps_max;
+    const int* cancel;     /* this solve's cancel token, or NULL        */
+    const int* ext_LB;     /* LB raised by another solve, or NULL       */
     int    timeout;
+    int    stop;           /* abort the search: timeout, or another
+                              worker finished it (parallel runs)       */
+
+    /* progress records (NULL = none) */
+    ProgressRing* progress;
 
-    /* callback */
-    ProgressCB callback;
+    /* parallel search (see parallel.h); NULL / 0 when sequential */
+    struct ParShared* shared;
+    int        worker_id;
+
+    /* conflict sets and nogoods (see backjump.h); NULL = chronological */
+    struct BJState*   bj;
+
+#ifdef BB_STATS
+    BBStats    stats;
+#endif
 } BBState;
 
+/* ── Statistics hooks (see BBStats) ──────────────────────────────────
+ * BB_TIMED(s, phase, stmt) runs stmt and charges its cycles to phase;
+ * BB_STAT(stmt) runs stmt only in BB_STATS builds.
+ * ─────────────────────────────────────────────────────────────────── */
+#ifdef BB_STATS
+  #define BB_TIMED(s, ph, stmt) do {                              \
+          uint64_t bb_t0_ = bb_cycles();                          \
+          stmt;                                                   \
+          (s)->stats.cycles[ph] += bb_cycles() - bb_t0_;          \
+          (s)->stats.calls[ph]++;                                 \
+      } while (0)
+  #define BB_STAT(stmt) do { stmt; } while (0)
+
+static inline int bb_stat_slot(int i, int cap) { return i < cap ? i : cap - 1; }
+
+/* Node entered at depth d */
+static inline void bb_stat_node(BBState* s, int d) {
+    s->stats.depth_nodes[bb_stat_slot(d, BB_STATS_DEPTHS)]++;
+    if ((uint64_t)d > s->stats.max_depth) s->stats.max_depth = (uint64_t)d;
+}
+
+/* Inner node at depth d bound-tested; cut = it was pruned */
+static inline void bb_stat_test(BBState* s, int d, int cut) {
+    int i = bb_stat_slot(d, BB_STATS_DEPTHS);
+    s->stats.depth_tests[i]++;
+    s->stats.depth_cuts[i] += cut != 0;
+}
+
+/* Branching node done after taking `children` branches */
+static inline void bb_stat_branch(BBState* s, int children) {
+    s->stats.branching[bb_stat_slot(children, BB_STATS_BRANCH)]++;
+}
+
+/* End of solve(): this state's totals into its progress ring */
+static inline void bb_stats_flush(const BBState* s) {
+    if (s->progress) bb_stats_add(&s->progress->stats, &s->stats);
+}
+#else
+  #define BB_TIMED(s, ph, stmt) do { stmt; } while (0)
+  #define BB_STAT(stmt)         do { } while (0)
+#endif
+
+/* ── Optional start-up inputs / outputs of the engines' solve() drivers
+ * A zeroed BBStart is a plain cold run.
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    const unsigned char* ckpt;          /* resume this checkpoint      */
+    int                  ckpt_len;
+    unsigned char*       out_ckpt;      /* checkpoint on timeout       */
+    int*                 out_ckpt_len;
+
+    int        warm_UB;                 /* > 0: warm_coloring is an    */
+    const int* warm_coloring;           /*   incumbent with < warm_UB  */
+    int        known_LB;                /* proven lower bound (or 0)   */
+    const int* shared_LB;               /* LB the caller may raise     */
+                                        /*   while this runs, or NULL  */
+
+    int*       out_winner;              /* portfolio: member that      */
+                                        /*   proved it, -1 = none      */
+
+    int        backjump;                /* BB_BACKJUMP | BB_NOGOODS    */
+    long*      out_jumps;               /* += frames backjumped over   */
+    long*      out_nogood_cuts;         /* += branches cut by nogoods  */
+
+    const int* cancel;                  /* cancel token, or NULL       */
+    int*       out_searched;            /* 1: the B&B state was built, */
+                                        /*   so K is proven unless it  */
+                                        /*   timed out; 0: heuristic K */
+} BBStart;
+
 /* ── Binary search in sorted adjacency list ─────────────────────────── */
 static inline int adj_has(const int* adj, int sv, int dv, int target) {
     int lo = sv, hi = sv + dv - 1;
@@ -93,53 +489,447 @@ static inline int adj_has(const int* adj, int sv, int dv, int target) {
     return 0;
 }
 
-/* ── Assign color c to vertex v, update DSAT of uncolored neighbors ── */
-static inline void colorier(BBState* s, int v, int c) {
-    s->color[v] = c;
-    for (int j = s->start[v]; j < s->start[v] + s->deg[v]; j++) {
-        int w = s->adj[j];
-        if (s->color[w] != -1) continue;
-        if (!CS_HAS(s->cset[w], c)) { CS_ADD(s->cset[w], c); s->dsat[w]++; }
+/* ── 64-bit content hash of the CSR graph (FNV-1a over n and rows) ───
+ * Identifies a graph across runs: result cache keys, checkpoints.
+ * Adjacency rows are sorted, so equal graphs hash equal.
+ * ─────────────────────────────────────────────────────────────────── */
+static inline uint64_t graph_fingerprint(int n, const int* adj,
+                                         const int* start, const int* deg) {
+    uint64_t h = 14695981039346656037ULL;
+#define FP_MIX(x) (h = (h ^ (uint32_t)(x)) * 1099511628211ULL)
+    FP_MIX(n);
+    for (int v = 0; v < n; v++) {
+        FP_MIX(deg[v]);
+        for (int j = start[v]; j < start[v] + deg[v]; j++) FP_MIX(adj[j]);
     }
+#undef FP_MIX
+    return h;
 }
 
-/* ── Remove color c from vertex v, restore DSAT of uncolored neighbors */
-static inline void decolorier(BBState* s, int v, int c) {
-    s->color[v] = -1;
-    for (int j = s->start[v]; j < s->start[v] + s->deg[v]; j++) {
-        int w = s->adj[j];
-        if (s->color[w] != -1) continue;
-        if (!CS_HAS(s->cset[w], c)) continue;
-        /* Color c still present via another colored neighbor of w? */
-        int still = 0;
-        for (int k = s->start[w]; k < s->start[w] + s->deg[w] && !still; k++) {
-            int x = s->adj[k];
-            if (x != v && s->color[x] == c) still = 1;
+/* ── Adjacency bit-matrix backend ──────────────────────────────────────
+ * Dense graphs get a packed n × n bit-matrix so adjacency tests are
+ * O(1) and neighbourhood intersections are word-wise AND + popcount.
+ * Chosen when it fits in ADJMAT_MAX_BYTES and a matrix row is no
+ * longer (in words) than the average CSR row; large sparse inputs
+ * stay on the CSR path.
+ * ─────────────────────────────────────────────────────────────────── */
+#define ADJ_CSR     0
+#define ADJ_BITSET  1
+
+#define ADJMAT_MAX_BYTES  (64u << 20)
+
+static inline int adjmat_wanted(int n, const int* deg) {
+    if (n <= 0) return 0;
+    size_t words = ((size_t)n + 63) >> 6;
+    if ((size_t)n * words * sizeof(uint64_t) > ADJMAT_MAX_BYTES) return 0;
+    long long sum = 0;
+    for (int v = 0; v < n; v++) sum += deg[v];
+    return sum >= (long long)n * (long long)words;
+}
+
+/* Returns a calloc'd matrix (caller frees) or NULL on failure */
+static inline uint64_t* adjmat_build(int n, const int* adj, const int* start,
+                                     const int* deg, int* out_words) {
+    int words = (n + 63) >> 6;
+    uint64_t* m = (uint64_t*)calloc((size_t)n * words, sizeof(uint64_t));
+    if (!m) return NULL;
+    for (int u = 0; u < n; u++) {
+        uint64_t* row = m + (size_t)u * words;
+        for (int j = start[u]; j < start[u] + deg[u]; j++)
+            row[adj[j] >> 6] |= 1ULL << (adj[j] & 63);
+    }
+    *out_words = words;
+    return m;
+}
+
+/* ── 16-bit copy of the CSR adjacency ──────────────────────────────────
+ * Halves the bytes a neighbour loop streams. Same row offsets as adj;
+ * NULL (callers keep the int ids) when n > BB_IX16_MAX_N or on failure.
+ * Caller frees, or hands it to a state with bb_use_adj16().
+ * ─────────────────────────────────────────────────────────────────── */
+static inline uint16_t* adj16_build(int n, const int* adj, const int* start,
+                                    const int* deg) {
+    if (n <= 0 || n > BB_IX16_MAX_N) return NULL;
+    size_t entries = 0;
+    for (int v = 0; v < n; v++)
+        if ((size_t)start[v] + deg[v] > entries) entries = (size_t)start[v] + deg[v];
+    uint16_t* a = (uint16_t*)malloc((entries + 1) * sizeof(uint16_t));
+    if (!a) return NULL;
+    for (int v = 0; v < n; v++)
+        for (int j = start[v]; j < start[v] + deg[v]; j++) a[j] = (uint16_t)adj[j];
+    return a;
+}
+
+static inline int adjmat_has(const uint64_t* m, int words, int u, int v) {
+    return (int)((m[(size_t)u * words + (v >> 6)] >> (v & 63)) & 1ULL);
+}
+
+/* |row(u) ∩ set| for a words-long bitset */
+static inline int adjmat_count_and(const uint64_t* m, int words, int u,
+                                   const uint64_t* set) {
+    const uint64_t* row = m + (size_t)u * words;
+    int cnt = 0;
+    for (int i = 0; i < words; i++) cnt += __builtin_popcountll(row[i] & set[i]);
+    return cnt;
+}
+
+/* ── Packed bit-row primitives ─────────────────────────────────────────
+ * Rows of `words` uint64_t. The intersection test exits on the first
+ * overlapping block; long rows use AVX2 when the CPU has it (checked
+ * once per translation unit) or NEON on ARM, else plain 64-bit words.
+ * ─────────────────────────────────────────────────────────────────── */
+static inline int bitrow_has(const uint64_t* row, int i) {
+    return (int)((row[i >> 6] >> (i & 63)) & 1ULL);
+}
+
+static inline int bitrow_count(const uint64_t* row, int words) {
+    int cnt = 0;
+    for (int i = 0; i < words; i++) cnt += __builtin_popcountll(row[i]);
+    return cnt;
+}
+
+#if BITROW_AVX2
+__attribute__((target("avx2")))
+static int bitrow_intersects_avx2(const uint64_t* a, const uint64_t* b, int words) {
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                     _mm256_loadu_si256((const __m256i*)(b + i)));
+        if (!_mm256_testz_si256(x, x)) return 1;
+    }
+    for (; i < words; i++) if (a[i] & b[i]) return 1;
+    return 0;
+}
+
+/* Probed once per translation unit; racing first callers store the same
+   answer, relaxed atomics keep that well-defined */
+static inline int bitrow_has_avx2(void) {
+    static int cached = -1;
+    int c = __atomic_load_n(&cached, __ATOMIC_RELAXED);
+    if (c < 0) {
+        c = __builtin_cpu_supports("avx2") ? 1 : 0;
+        __atomic_store_n(&cached, c, __ATOMIC_RELAXED);
+    }
+    return c;
+}
+#endif
+
+static inline int bitrow_intersects(const uint64_t* a, const uint64_t* b, int words) {
+    int i = 0;
+#if BITROW_AVX2
+    if (words >= 8 && bitrow_has_avx2()) return bitrow_intersects_avx2(a, b, words);
+#elif BITROW_NEON
+    for (; i + 2 <= words; i += 2) {
+        uint64x2_t x = vandq_u64(vld1q_u64(a + i), vld1q_u64(b + i));
+        if (vgetq_lane_u64(x, 0) | vgetq_lane_u64(x, 1)) return 1;
+    }
+#endif
+    for (; i < words; i++) if (a[i] & b[i]) return 1;
+    return 0;
+}
+
+/* ── Selection index primitives ─────────────────────────────────────── */
+static inline void q_insert(BBState* s, int v, int d) {
+    int r = s->vert[v].rank, w = r >> 6;
+    uint64_t* row = s->qbits + (size_t)d * s->qwords;
+    if (!row[w]) s->qsumm[(size_t)d * s->qsw + (w >> 6)] |= 1ULL << (w & 63);
+    row[w] |= 1ULL << (r & 63);
+    s->qcount[d]++;
+    if (d > s->qmax) s->qmax = d;
+}
+
+static inline void q_remove(BBState* s, int v, int d) {
+    int r = s->vert[v].rank, w = r >> 6;
+    uint64_t* row = s->qbits + (size_t)d * s->qwords;
+    row[w] &= ~(1ULL << (r & 63));
+    if (!row[w]) s->qsumm[(size_t)d * s->qsw + (w >> 6)] &= ~(1ULL << (w & 63));
+    s->qcount[d]--;
+    while (s->qmax >= 0 && s->qcount[s->qmax] == 0) s->qmax--;
+}
+
+/* Insert before removing so qmax never scans past the target level */
+static inline void q_move(BBState* s, int v, int from, int to) {
+    q_insert(s, v, to);
+    q_remove(s, v, from);
+}
+
+/* First rank ≥ r present at level d, or -1 */
+static inline int q_next(const BBState* s, int d, int r) {
+    const uint64_t* row = s->qbits + (size_t)d * s->qwords;
+    const uint64_t* sm  = s->qsumm + (size_t)d * s->qsw;
+    int w = r >> 6;
+    if (w >= s->qwords) return -1;
+    uint64_t bits = row[w] & (~0ULL << (r & 63));
+    if (bits) return (w << 6) + __builtin_ctzll(bits);
+
+    /* Skip to the next non-zero word through the summary */
+    w++;
+    int i = w >> 6;
+    if (i >= s->qsw) return -1;
+    uint64_t sb = sm[i] & ((w & 63) ? (~0ULL << (w & 63)) : ~0ULL);
+    while (!sb) { if (++i >= s->qsw) return -1; sb = sm[i]; }
+    w = (i << 6) + __builtin_ctzll(sb);
+    return (w << 6) + __builtin_ctzll(row[w]);
+}
+
+/* ── Allocate the owned search arrays, all vertices uncolored ────────
+ * ncolors bounds the colors that colorier() may ever assign
+ * (UB_init for the B&B engines). The layout starts on int ids,
+ * BB_IX32 or BB_IX32W by the maximum degree; bb_use_adj16() narrows
+ * the ids. Returns 0 on allocation failure or ncolors > BB_MAX_COLORS.
+ * ─────────────────────────────────────────────────────────────────── */
+static inline int bb_init(BBState* s, int n, const int* adj,
+                          const int* start, const int* deg, int ncolors) {
+    memset(s, 0, sizeof(*s));
+    s->n = n; s->adj = adj; s->start = start; s->deg = deg;
+    s->ncolors = ncolors > 0 ? ncolors : 1;
+    int nn = n > 0 ? n : 1;
+    if (s->ncolors > BB_MAX_COLORS) return 0;
+
+    int max_deg = 0;
+    for (int v = 0; v < n; v++) if (deg[v] > max_deg) max_deg = deg[v];
+    s->ix = max_deg > UINT16_MAX ? BB_IX32W : BB_IX32;
+    size_t cc = s->ix == BB_IX32W ? sizeof(int) : sizeof(uint16_t);
+
+    s->vert  = (BBVert*)aligned_calloc((size_t)nn * sizeof(BBVert));
+    s->cwords = cs_words(s->ncolors);
+    s->cset  = (ColorSet*)aligned_calloc((size_t)nn * s->cwords * sizeof(ColorSet));
+    /* n · ncolors counters of cc bytes: the one array that grows with
+       the incumbent. DSATUR keeps UB_init ≤ Δ + 1 (a warm start may
+       bring more); BB_MAX_COLORS caps it at 64 KiB per vertex
+       (128 KiB under BB_IX32W). n = 10⁴ with UB_init = 1000 takes 20 MB */
+    s->ccnt  = aligned_calloc((size_t)nn * s->ncolors * cc);
+
+    s->qwords  = (nn + 63) >> 6;
+    s->qsw     = (s->qwords + 63) >> 6;
+    s->qlevels = s->ncolors + 1;
+    s->order   = (int*)malloc(nn * sizeof(int));
+    s->qbits   = (uint64_t*)calloc((size_t)s->qlevels * s->qwords, sizeof(uint64_t));
+    s->qsumm   = (uint64_t*)calloc((size_t)s->qlevels * s->qsw, sizeof(uint64_t));
+    s->qcount  = (int*)calloc(s->qlevels, sizeof(int));
+    s->qmax    = -1;
+    s->stack   = (BBFrame*)malloc((size_t)(nn + 1) * sizeof(BBFrame));
+
+    if (!s->vert || !s->cset || !s->ccnt || !s->order ||
+        !s->qbits || !s->qsumm || !s->qcount || !s->stack) return 0;
+
+    /* Stable counting sort by degree descending → rank */
+    int* bucket = (int*)calloc(max_deg + 2, sizeof(int));
+    if (!bucket) return 0;
+    for (int v = 0; v < n; v++) bucket[max_deg - deg[v] + 1]++;
+    for (int d = 1; d <= max_deg + 1; d++) bucket[d] += bucket[d - 1];
+    for (int v = 0; v < n; v++) s->order[bucket[max_deg - deg[v]]++] = v;
+    free(bucket);
+
+    for (int r = 0; r < n; r++) s->vert[s->order[r]].rank = r;
+    for (int v = 0; v < n; v++) {
+        BBVert* x = &s->vert[v];
+        x->color = -1; x->start = start[v]; x->deg = deg[v];
+        q_insert(s, v, 0);
+    }
+    return 1;
+}
+
+static inline void bb_free(BBState* s) {
+    aligned_free(s->vert); aligned_free(s->cset); aligned_free(s->ccnt);
+    free(s->adj16); free(s->order);
+    free(s->qbits); free(s->qsumm); free(s->qcount);
+    free(s->amat); free(s->stack);
+    arena_free(&s->ws);
+    s->vert = NULL; s->cset = NULL; s->ccnt = NULL;
+    s->adj16 = NULL; s->order = NULL;
+    s->qbits = NULL; s->qsumm = NULL; s->qcount = NULL;
+    s->amat = NULL; s->stack = NULL; s->sp = 0;
+    s->bound_state = NULL;
+}
+
+/* ── Switch s to 16-bit neighbour ids (adj16_build() of its graph) ────
+ * s frees a16 like amat; NULL keeps the int ids. Sharing states set
+ * adj16 = NULL before bb_free() on all but the owner.
+ * ─────────────────────────────────────────────────────────────────── */
+static inline void bb_use_adj16(BBState* s, uint16_t* a16) {
+    s->adj16 = a16;
+    if (a16) s->ix = BB_IX16;
+}
+
+/* ── Current colouring of s into out[0..n-1] (-1 = uncolored) ──────── */
+static inline void bb_copy_colors(const BBState* s, int* out) {
+    for (int v = 0; v < s->n; v++) out[v] = s->vert[v].color;
+}
+
+/* ── Permute vertices of equal degree within the rank order ───────────
+ * Changes every DSATUR tie-break (equal DSAT and degree) without
+ * touching the selection rule itself. Call before the first colorier()
+ * while every vertex is still at level 0. seed 0 keeps index order.
+ * ─────────────────────────────────────────────────────────────────── */
+static inline void bb_shuffle_ties(BBState* s, unsigned seed) {
+    if (seed == 0) return;
+    uint32_t x = seed * 2654435761u + 1u;
+    for (int v = 0; v < s->n; v++) q_remove(s, v, 0);
+    for (int lo = 0; lo < s->n; ) {
+        int hi = lo + 1;
+        while (hi < s->n && s->deg[s->order[hi]] == s->deg[s->order[lo]]) hi++;
+        for (int i = hi - 1; i > lo; i--) {          /* Fisher-Yates */
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            int j = lo + (int)(x % (uint32_t)(i - lo + 1));
+            int t = s->order[i]; s->order[i] = s->order[j]; s->order[j] = t;
         }
-        if (!still) { CS_DEL(s->cset[w], c); s->dsat[w]--; }
+        lo = hi;
     }
+    for (int r = 0; r < s->n; r++) s->vert[s->order[r]].rank = r;
+    for (int v = 0; v < s->n; v++) q_insert(s, v, 0);
 }
 
-/* ── Standard DSATUR vertex selection (no extra tie-breaking) ─────── */
-static inline int select_dsatur(const BBState* s) {
-    int best = -1;
-    for (int v = 0; v < s->n; v++) {
-        if (s->color[v] != -1) continue;
-        if (best == -1) { best = v; continue; }
-        if (s->dsat[v] > s->dsat[best] ||
-           (s->dsat[v] == s->dsat[best] && s->deg[v] > s->deg[best]))
-            best = v;
+/* ── u ── v in G, through whichever backend s carries ──────────────── */
+static inline int bb_adjacent(const BBState* s, int u, int v) {
+    if (s->amat) return adjmat_has(s->amat, s->awords, u, v);
+    return adj_has(s->adj, s->start[u], s->deg[u], v);
+}
+
+/* ── cset row of v, W = s->cwords (or that value as a constant) ────── */
+CS_INLINE ColorSet* bb_cset(const BBState* s, int v, int W) {
+    return s->cset + (size_t)v * W;
+}
+
+/* ── Neighbour id at CSR position j, L = s->ix (or a constant) ─────── */
+CS_INLINE int bb_nbr(const BBState* s, int j, int L) {
+    return L == BB_IX16 ? (int)s->adj16[j] : s->adj[j];
+}
+
+/* ── ccnt[w*ncolors + c], and adding d to it (returns the new value) ── */
+CS_INLINE int bb_ccnt(const BBState* s, int w, int c, int L) {
+    size_t i = (size_t)w * s->ncolors + c;
+    if (L == BB_IX32W) return ((const int*)s->ccnt)[i];
+    return ((const uint16_t*)s->ccnt)[i];
+}
+
+CS_INLINE int bb_ccnt_add(BBState* s, int w, int c, int d, int L) {
+    size_t i = (size_t)w * s->ncolors + c;
+    if (L == BB_IX32W) return ((int*)s->ccnt)[i] += d;
+    uint16_t* p = (uint16_t*)s->ccnt + i;
+    return *p = (uint16_t)(*p + d);
+}
+
+/* ── Assign color c to vertex v, update DSAT of uncolored neighbors ──
+ * ccnt counts how many neighbors of w hold each color, so a color
+ * enters cset[w] on the 0 → 1 transition only. W = s->cwords,
+ * L = s->ix.
+ * ─────────────────────────────────────────────────────────────────── */
+CS_INLINE void colorier_w(BBState* s, int v, int c, int W, int L) {
+    BBVert* x = &s->vert[v];
+    x->color = (int16_t)c;
+    q_remove(s, v, x->dsat);
+    for (int j = x->start, e = x->start + x->deg; j < e; j++) {
+        int w = bb_nbr(s, j, L);
+        BBVert* y = &s->vert[w];
+        if (y->color != -1) continue;
+        if (bb_ccnt_add(s, w, c, 1, L) == 1) {
+            cs_add(bb_cset(s, w, W), c, W);
+            q_move(s, w, y->dsat, y->dsat + 1); y->dsat++;
+        }
     }
-    return best;
 }
 
-/* ── Fire progress callback every 500 nodes ─────────────────────────── */
-static inline void maybe_cb(BBState* s) {
-    if (!s->callback) return;
-    if (s->nodes_visited == 1 || s->nodes_visited % 500 == 0) {
-        double t = now_s() - s->time_start;
-        s->callback(s->nodes_visited, s->UB, s->LB, t, s->branches_cut);
+/* ── Remove color c from vertex v, restore DSAT of uncolored neighbors
+ * Exact inverse of colorier(): in DFS order the set of colored
+ * neighbors of each w is the same as when v was colored, so the
+ * 1 → 0 transition of ccnt is the last occurrence of c around w.
+ * O(deg(v)), no rescan of N(w).
+ * ─────────────────────────────────────────────────────────────────── */
+CS_INLINE void decolorier_w(BBState* s, int v, int c, int W, int L) {
+    BBVert* x = &s->vert[v];
+    x->color = -1;
+    for (int j = x->start, e = x->start + x->deg; j < e; j++) {
+        int w = bb_nbr(s, j, L);
+        BBVert* y = &s->vert[w];
+        if (y->color != -1) continue;
+        if (bb_ccnt_add(s, w, c, -1, L) == 0) {
+            cs_del(bb_cset(s, w, W), c, W);
+            q_move(s, w, y->dsat, y->dsat - 1); y->dsat--;
+        }
     }
+    q_insert(s, v, x->dsat);
+}
+
+/* Runtime-width versions for code outside the per-W search loops */
+static inline void colorier(BBState* s, int v, int c)   { colorier_w(s, v, c, s->cwords, s->ix); }
+static inline void decolorier(BBState* s, int v, int c) { decolorier_w(s, v, c, s->cwords, s->ix); }
+
+/* ── Colours in use below branch f->c of frame f ──────────────────── */
+static inline int bb_child_k(const BBFrame* f) {
+    return f->c + 1 > f->k ? f->c + 1 : f->k;
+}
+
+/* ── Re-colour a path saved by a stopped search. Returns the depth ─── */
+static inline int bb_replay(BBState* s) {
+    int sp = s->sp;
+    for (int i = 0; i < sp; i++) colorier(s, s->stack[i].v, s->stack[i].c);
+    s->sp = 0;
+    return sp;
+}
+
+/* ── Undo the colours of path frames 0..sp-1 ─────────────────────── */
+static inline void bb_unwind(BBState* s, int sp) {
+    for (int i = sp - 1; i >= 0; i--) decolorier(s, s->stack[i].v, s->stack[i].c);
+}
+
+/* ── Undo the path on stop, keeping its frames for the next explore() */
+static inline void bb_suspend(BBState* s, int sp) {
+    bb_unwind(s, sp);
+    s->sp = sp;
+}
+
+/* ── Standard DSATUR vertex selection (no extra tie-breaking) ───────
+ * Max DSAT, then max degree, then lowest index: the lowest rank of the
+ * highest non-empty level. O(n/4096) through the summary words.
+ * ─────────────────────────────────────────────────────────────────── */
+static inline int select_dsatur(const BBState* s) {
+    if (s->qmax < 0) return -1;
+    return s->order[q_next(s, s->qmax, 0)];
+}
+
+/* ── Cancellation token ────────────────────────────────────────────────
+ * A per-solve int the caller owns, 0 at the start. bb_cancel() sets it
+ * from any thread; the solves given that token (and every thread they
+ * run) stop at their next check, others are not affected. A token stays
+ * set, so each solve gets a fresh one. NULL = cannot be cancelled.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT void bb_cancel(int* cancel);
+
+static inline int bb_cancelled(const int* cancel) {
+    return cancel && __atomic_load_n(cancel, __ATOMIC_RELAXED);
+}
+
+/* out_cancelled of the entry points: stopped early, and on the token */
+static inline int bb_was_cancelled(const int* cancel, int timeout) {
+    return timeout && bb_cancelled(cancel);
+}
+
+/* ── Stop test at node entry: time limit or cancel ─────────────────────
+ * The token is one relaxed load per node; the clock is only read every
+ * BB_CLOCK_EVERY nodes.
+ * ─────────────────────────────────────────────────────────────────── */
+#define BB_CLOCK_EVERY  256
+
+static inline int bb_time_up(const BBState* s) {
+    if (bb_cancelled(s->cancel)) return 1;
+    if (s->nodes_visited & (BB_CLOCK_EVERY - 1)) return 0;
+    return now_s() - s->time_start > (double)s->temps_max;
+}
+
+/* ── Adopt a raised external LB (blocks.c): the search ends once UB ≤ LB */
+static inline void bb_poll_LB(BBState* s) {
+    if (!s->ext_LB) return;
+    int lb = __atomic_load_n(s->ext_LB, __ATOMIC_RELAXED);
+    if (lb > s->LB) s->LB = lb;
+}
+
+/* ── Progress record every PROGRESS_EVERY nodes, depth = B&B depth ─── */
+static inline void bb_progress(BBState* s, int depth) {
+    if (!s->progress) return;
+    if (s->nodes_visited == 1 || s->nodes_visited % PROGRESS_EVERY == 0)
+        progress_push(s->progress, s->nodes_visited, s->branches_cut,
+                      s->UB, s->LB, depth, now_s() - s->time_start);
 }
 
 #endif /* COLORING_H */
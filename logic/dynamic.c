@@ -0,0 +1,508 @@
+/*
+ * dynamic.c
+ * ─────────
+ * Mutable CSR, local colouring repair and the B&B fall-back (see
+ * dynamic.h).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "heuristics.h"
+#include "dynamic.h"
+
+#define DYN_ROW_SLACK  4            /* spare slots per row on first build */
+#define DYN_KEMPE_WORK (1L << 20)   /* adjacency entries one repair scans */
+
+/* ── Engine entry points (bb_sewell.c, bb_furini.c) ───────────────── */
+#define SOLVE_ARGS int n, int* adj, int* start, int* deg,                 \
+                   int temps_max, ProgressRing* progress,                 \
+                   const int* cancel,                                     \
+                   int* out_K, int* out_coloring,                         \
+                   int* out_LB, int* out_UB_init,                         \
+                   int* out_optimal, long* out_nodes, long* out_cuts,     \
+                   double* out_time, int* out_timeout,                    \
+                   int* out_cancelled, int* out_backend
+
+EXPORT int sewell_solve_warm(SOLVE_ARGS, int warm_UB, const int* warm_coloring, int known_LB);
+EXPORT int furini_solve_warm(SOLVE_ARGS, int warm_UB, const int* warm_coloring, int known_LB);
+
+struct DynGraph {
+    int   n;                /* vertex ids handed out                      */
+    int   vcap;             /* room for ids in the per-vertex arrays      */
+    char* alive;
+    int*  rstart;           /* row v = pool[rstart[v] .. + rdeg[v]),      */
+    int*  rdeg;             /*   sorted, with room for rcap[v] entries    */
+    int*  rcap;
+    int*  pool;
+    long  pool_len;         /* slots handed out to rows (holes included)  */
+    long  pool_cap;
+    long  live;             /* sum of rcap over the live rows             */
+
+    int*  color;            /* -1 = dead, or waiting for dyn_solve()      */
+    int   K;                /* colours 0..K-1 in color[]                  */
+    int   LB;               /* valid lower bound of the current graph     */
+    int   seeded;           /* color[] holds a colouring                  */
+    int   deleted;          /* deletions since the last solve             */
+
+    int*  pending;          /* vertices uncoloured by updates             */
+    int   npending, pcap;
+};
+
+/* ── Rows ──────────────────────────────────────────────────────────── */
+
+/* Room for need more slots at the end of the pool. A full pool is
+   rebuilt at twice the live size, which also drops the holes left by
+   moved rows. */
+static int pool_reserve(DynGraph* g, long need) {
+    if (g->pool_len + need <= g->pool_cap) return 1;
+    long cap = 2 * (g->live + need) + 16;
+    int* pool = (int*)malloc(cap * sizeof(int));
+    if (!pool) return 0;
+    long pos = 0;
+    for (int v = 0; v < g->n; v++) {
+        if (!g->rcap[v]) { g->rstart[v] = 0; continue; }
+        memcpy(pool + pos, g->pool + g->rstart[v], g->rdeg[v] * sizeof(int));
+        g->rstart[v] = (int)pos;
+        pos += g->rcap[v];
+    }
+    free(g->pool);
+    g->pool = pool; g->pool_len = pos; g->pool_cap = cap;
+    return 1;
+}
+
+/* Move row v to the end of the pool with twice the room */
+static int row_grow(DynGraph* g, int v) {
+    int cap = 2 * g->rcap[v] + DYN_ROW_SLACK;
+    if (!pool_reserve(g, cap)) return 0;
+    memcpy(g->pool + g->pool_len, g->pool + g->rstart[v], g->rdeg[v] * sizeof(int));
+    g->rstart[v] = (int)g->pool_len;
+    g->pool_len += cap;
+    g->live     += cap - g->rcap[v];
+    g->rcap[v]   = cap;
+    return 1;
+}
+
+/* First position of row v holding a neighbour ≥ u */
+static int row_lower(const DynGraph* g, int v, int u) {
+    const int* row = g->pool + g->rstart[v];
+    int lo = 0, hi = g->rdeg[v];
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (row[mid] < u) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static int row_has(const DynGraph* g, int v, int u) {
+    int i = row_lower(g, v, u);
+    return i < g->rdeg[v] && g->pool[g->rstart[v] + i] == u;
+}
+
+/* 1 = inserted, 0 = already there, -1 = out of memory */
+static int row_insert(DynGraph* g, int v, int u) {
+    int i = row_lower(g, v, u);
+    if (i < g->rdeg[v] && g->pool[g->rstart[v] + i] == u) return 0;
+    if (g->rdeg[v] == g->rcap[v] && !row_grow(g, v)) return -1;
+    int* row = g->pool + g->rstart[v];
+    memmove(row + i + 1, row + i, (g->rdeg[v] - i) * sizeof(int));
+    row[i] = u;
+    g->rdeg[v]++;
+    return 1;
+}
+
+static int row_erase(DynGraph* g, int v, int u) {
+    int i = row_lower(g, v, u);
+    int* row = g->pool + g->rstart[v];
+    if (i == g->rdeg[v] || row[i] != u) return 0;
+    memmove(row + i, row + i + 1, (g->rdeg[v] - i - 1) * sizeof(int));
+    g->rdeg[v]--;
+    return 1;
+}
+
+/* ── Vertices ──────────────────────────────────────────────────────── */
+
+static int vert_reserve(DynGraph* g, int need) {
+    if (need <= g->vcap) return 1;
+    int cap = 2 * need + 16;
+    char* alive  = (char*)realloc(g->alive,  cap);
+    if (alive) g->alive = alive;
+    int*  rstart = (int*)realloc(g->rstart, cap * sizeof(int));
+    if (rstart) g->rstart = rstart;
+    int*  rdeg   = (int*)realloc(g->rdeg,   cap * sizeof(int));
+    if (rdeg) g->rdeg = rdeg;
+    int*  rcap   = (int*)realloc(g->rcap,   cap * sizeof(int));
+    if (rcap) g->rcap = rcap;
+    int*  color  = (int*)realloc(g->color,  cap * sizeof(int));
+    if (color) g->color = color;
+    if (!alive || !rstart || !rdeg || !rcap || !color) return 0;
+    g->vcap = cap;
+    return 1;
+}
+
+static int pending_reserve(DynGraph* g) {
+    if (g->npending < g->pcap) return 1;
+    int cap = 2 * g->pcap + 16;
+    int* p = (int*)realloc(g->pending, cap * sizeof(int));
+    if (!p) return 0;
+    g->pending = p; g->pcap = cap;
+    return 1;
+}
+
+static int pending_push(DynGraph* g, int v) {
+    if (!pending_reserve(g)) return 0;
+    g->pending[g->npending++] = v;
+    return 1;
+}
+
+static int dyn_live(const DynGraph* g, int v) {
+    return v >= 0 && v < g->n && g->alive[v];
+}
+
+EXPORT DynGraph* dyn_new(int n, const int* adj, const int* start, const int* deg) {
+    DynGraph* g = (DynGraph*)calloc(1, sizeof(DynGraph));
+    if (!g || n < 0 || !vert_reserve(g, n)) { dyn_free(g); return NULL; }
+    long total = 0;
+    for (int v = 0; v < n; v++) total += deg[v] + DYN_ROW_SLACK;
+    g->pool_cap = total + 16;
+    g->pool = (int*)malloc(g->pool_cap * sizeof(int));
+    if (!g->pool) { dyn_free(g); return NULL; }
+    g->n = n;
+    for (int v = 0; v < n; v++) {
+        g->alive[v]  = 1;
+        g->rstart[v] = (int)g->pool_len;
+        g->rdeg[v]   = deg[v];
+        g->rcap[v]   = deg[v] + DYN_ROW_SLACK;
+        g->color[v]  = -1;
+        memcpy(g->pool + g->pool_len, adj + start[v], deg[v] * sizeof(int));
+        g->pool_len += g->rcap[v];
+    }
+    g->live = g->pool_len;
+    return g;
+}
+
+EXPORT void dyn_free(DynGraph* g) {
+    if (!g) return;
+    free(g->alive); free(g->rstart); free(g->rdeg); free(g->rcap);
+    free(g->pool); free(g->color); free(g->pending);
+    free(g);
+}
+
+EXPORT int dyn_vertices(const DynGraph* g) { return g->n; }
+
+/* ── Updates ───────────────────────────────────────────────────────── */
+
+EXPORT int dyn_add_edge(DynGraph* g, int u, int v) {
+    if (!dyn_live(g, u) || !dyn_live(g, v) || u == v) return -1;
+    if (row_has(g, u, v)) return 0;
+    /* Reserve everything first so a failure leaves the graph as it was */
+    if (!pending_reserve(g)) return -1;
+    if (g->rdeg[u] == g->rcap[u] && !row_grow(g, u)) return -1;
+    if (g->rdeg[v] == g->rcap[v] && !row_grow(g, v)) return -1;
+    row_insert(g, u, v);
+    row_insert(g, v, u);
+    if (g->seeded && g->color[u] >= 0 && g->color[u] == g->color[v]) {
+        /* The end with fewer neighbours is the easier one to recolour */
+        int w = g->rdeg[u] < g->rdeg[v] ? u : v;
+        g->color[w] = -1;
+        pending_push(g, w);
+    }
+    return 1;
+}
+
+EXPORT int dyn_remove_edge(DynGraph* g, int u, int v) {
+    if (!dyn_live(g, u) || !dyn_live(g, v) || u == v) return -1;
+    if (!row_erase(g, u, v)) return 0;
+    row_erase(g, v, u);
+    g->deleted++;
+    if (g->LB > 0) g->LB--;
+    return 1;
+}
+
+EXPORT int dyn_add_vertex(DynGraph* g) {
+    if (g->n == INT_MAX || !vert_reserve(g, g->n + 1)) return -1;
+    if (g->seeded && !pending_push(g, g->n)) return -1;
+    int v = g->n++;
+    g->alive[v] = 1;
+    g->rstart[v] = 0; g->rdeg[v] = 0; g->rcap[v] = 0;
+    g->color[v] = -1;
+    return v;
+}
+
+EXPORT int dyn_remove_vertex(DynGraph* g, int v) {
+    if (v < 0 || v >= g->n) return -1;
+    if (!g->alive[v]) return 0;
+    const int* row = g->pool + g->rstart[v];
+    for (int i = 0; i < g->rdeg[v]; i++) row_erase(g, row[i], v);
+    g->live -= g->rcap[v];
+    g->rdeg[v] = g->rcap[v] = 0;
+    g->alive[v] = 0;
+    g->color[v] = -1;
+    g->deleted++;
+    if (g->LB > 0) g->LB--;
+    return 1;
+}
+
+/* ── Colours ───────────────────────────────────────────────────────── */
+
+/* Renumber the colours in use to 0..K-1 (first-use order); returns K.
+   map: scratch of n + 1 ints. */
+static int normalize(DynGraph* g, int* map) {
+    for (int c = 0; c <= g->n; c++) map[c] = -1;
+    int K = 0;
+    for (int v = 0; v < g->n; v++) {
+        int c = g->color[v];
+        if (c < 0) continue;
+        if (map[c] < 0) map[c] = K++;
+        g->color[v] = map[c];
+    }
+    return K;
+}
+
+EXPORT int dyn_seed(DynGraph* g, const int* coloring, int LB) {
+    for (int v = 0; v < g->n; v++) {
+        if (!g->alive[v]) continue;
+        if (coloring[v] < 0 || coloring[v] > g->n) return 0;
+        const int* row = g->pool + g->rstart[v];
+        for (int i = 0; i < g->rdeg[v]; i++)
+            if (coloring[row[i]] == coloring[v]) return 0;
+    }
+    int* map = (int*)malloc((g->n + 1) * sizeof(int));
+    if (!map) return 0;
+    for (int v = 0; v < g->n; v++) g->color[v] = g->alive[v] ? coloring[v] : -1;
+    g->K = normalize(g, map);
+    free(map);
+    if (LB > g->LB) g->LB = LB;
+    if (g->LB > g->K) g->LB = g->K;
+    g->seeded = 1;
+    g->deleted = 0;
+    g->npending = 0;
+    return 1;
+}
+
+/* ── Local repair ──────────────────────────────────────────────────────
+ * Stamped scratch over the vertices (nb, vis) and the colours (cmark);
+ * cnt holds n + 2 colours, queue and list up to n vertices.
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    int*  nb;
+    int*  vis;
+    int*  cmark;
+    int*  cnt;      /* per colour: class sizes, or a renumbering */
+    int*  queue;
+    int*  list;
+    int   stamp;
+    long  work;
+} Repair;
+
+/* Colour uncoloured v with some c < K: a colour none of its neighbours
+   has, else one that a (c, d) Kempe swap clears from its neighbourhood.
+   The swap recolours a two-colour component that touches v only in
+   colour c, so the colouring stays proper. Returns 0 if v stays
+   uncoloured. */
+static int repair_vertex(DynGraph* g, Repair* r, int v, int K) {
+    int* col = g->color;
+    const int* row = g->pool + g->rstart[v];
+    int dv = g->rdeg[v];
+
+    int s = ++r->stamp;
+    for (int i = 0; i < dv; i++)
+        if (col[row[i]] >= 0 && col[row[i]] < K) r->cmark[col[row[i]]] = s;
+    for (int c = 0; c < K; c++)
+        if (r->cmark[c] != s) { col[v] = c; return 1; }
+
+    int snb = ++r->stamp;
+    for (int i = 0; i < dv; i++) r->nb[row[i]] = snb;
+    r->work = 0;
+    for (int c = 0; c < K; c++) {
+        for (int d = 0; d < K; d++) {
+            if (d == c) continue;
+            if (r->work > DYN_KEMPE_WORK) return 0;
+            int sv = ++r->stamp, qh = 0, qt = 0, ok = 1;
+            for (int i = 0; i < dv; i++)
+                if (col[row[i]] == c) { r->vis[row[i]] = sv; r->queue[qt++] = row[i]; }
+            while (qh < qt && ok) {
+                int x = r->queue[qh++];
+                const int* rx = g->pool + g->rstart[x];
+                r->work += g->rdeg[x];
+                for (int j = 0; j < g->rdeg[x]; j++) {
+                    int y = rx[j];
+                    if (r->vis[y] == sv || (col[y] != c && col[y] != d)) continue;
+                    if (col[y] == d && r->nb[y] == snb) { ok = 0; break; }
+                    r->vis[y] = sv;
+                    r->queue[qt++] = y;
+                }
+            }
+            if (!ok) continue;
+            for (int i = 0; i < qt; i++) {
+                int x = r->queue[i];
+                col[x] = col[x] == c ? d : c;
+            }
+            col[v] = c;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Recolour the smallest class into the K-1 others; backup: n ints.
+   Returns 1 and lowers g->K on success, else restores the colouring. */
+static int drop_class(DynGraph* g, Repair* r, int* backup) {
+    int K = g->K, *cnt = r->cnt;
+    if (K < 2) return 0;
+    for (int c = 0; c < K; c++) cnt[c] = 0;
+    for (int v = 0; v < g->n; v++) if (g->color[v] >= 0) cnt[g->color[v]]++;
+    int cmin = 0;
+    for (int c = 1; c < K; c++) if (cnt[c] < cnt[cmin]) cmin = c;
+
+    memcpy(backup, g->color, g->n * sizeof(int));
+    int m = 0;
+    for (int v = 0; v < g->n; v++) {
+        if (g->color[v] == cmin)       { g->color[v] = -1; r->list[m++] = v; }
+        else if (g->color[v] == K - 1) g->color[v] = cmin;
+    }
+    for (int i = 0; i < m; i++) {
+        if (!repair_vertex(g, r, r->list[i], K - 1)) {
+            memcpy(g->color, backup, g->n * sizeof(int));
+            return 0;
+        }
+    }
+    g->K = K - 1;
+    return 1;
+}
+
+/* ── Live vertices as a plain CSR (rows stay sorted: ids keep order) ─ */
+typedef struct {
+    int  n;
+    int* adj;
+    int* start;
+    int* deg;
+    int* old_of;
+    int* new_of;    /* -1 for dead ids */
+} DynCSR;
+
+static void dyn_csr_free(DynCSR* c) {
+    free(c->adj); free(c->start); free(c->deg); free(c->old_of); free(c->new_of);
+    memset(c, 0, sizeof(*c));
+}
+
+static int dyn_csr(const DynGraph* g, DynCSR* c) {
+    memset(c, 0, sizeof(*c));
+    long entries = 0;
+    for (int v = 0; v < g->n; v++) entries += g->rdeg[v];
+    c->adj    = (int*)malloc((entries + 1) * sizeof(int));
+    c->start  = (int*)malloc((g->n + 1) * sizeof(int));
+    c->deg    = (int*)malloc((g->n + 1) * sizeof(int));
+    c->old_of = (int*)malloc((g->n + 1) * sizeof(int));
+    c->new_of = (int*)malloc((g->n + 1) * sizeof(int));
+    if (!c->adj || !c->start || !c->deg || !c->old_of || !c->new_of) {
+        dyn_csr_free(c);
+        return 0;
+    }
+    for (int v = 0; v < g->n; v++) {
+        c->new_of[v] = g->alive[v] ? c->n : -1;
+        if (g->alive[v]) c->old_of[c->n++] = v;
+    }
+    long pos = 0;
+    for (int i = 0; i < c->n; i++) {
+        int v = c->old_of[i];
+        const int* row = g->pool + g->rstart[v];
+        c->start[i] = (int)pos;
+        c->deg[i]   = g->rdeg[v];
+        for (int j = 0; j < g->rdeg[v]; j++) c->adj[pos++] = c->new_of[row[j]];
+    }
+    return 1;
+}
+
+/* ── Solve ─────────────────────────────────────────────────────────── */
+
+EXPORT int dyn_solve(DynGraph* g, int algo, int temps_max, int prove,
+                     ProgressRing* progress, const int* cancel,
+                     int* out_K, int* out_coloring, int* out_LB, int* out_optimal,
+                     long* out_nodes, long* out_cuts, double* out_time,
+                     int* out_timeout, int* out_cancelled, int* out_searched) {
+    double t0 = now_s();
+    if (algo != DYN_SEWELL && algo != DYN_FURINI) return 0;
+    int n = g->n;
+
+    Repair r;
+    memset(&r, 0, sizeof(r));
+    r.nb    = (int*)calloc(n + 1, sizeof(int));
+    r.vis   = (int*)calloc(n + 1, sizeof(int));
+    r.cmark = (int*)calloc(n + 2, sizeof(int));
+    r.cnt   = (int*)malloc((n + 2) * sizeof(int));
+    r.queue = (int*)malloc((n + 1) * sizeof(int));
+    r.list  = (int*)malloc((n + 1) * sizeof(int));
+    int* backup = (int*)malloc((n + 1) * sizeof(int));
+    DynCSR c;
+    memset(&c, 0, sizeof(c));
+    int ok = r.nb && r.vis && r.cmark && r.cnt && r.queue && r.list && backup;
+    int st = 1;
+
+    *out_nodes = 0; *out_cuts = 0; *out_timeout = 0; *out_cancelled = 0; *out_searched = 0;
+
+    /* Updates since the last solve: repair within K colours, else open
+       a new one. A first solve without a seed is a full search. */
+    int grow = !g->seeded;
+    if (ok && g->seeded) {
+        for (int i = 0; i < g->npending; i++) {
+            int v = g->pending[i];
+            if (!g->alive[v] || g->color[v] >= 0) continue;
+            if (!repair_vertex(g, &r, v, g->K)) { g->color[v] = g->K++; grow = 1; }
+        }
+        g->npending = 0;
+        g->K = normalize(g, r.cnt);
+    }
+
+    /* After deletions: a greedy clique may restore LB, and a colour
+       class may empty into the others */
+    if (ok && g->deleted && g->LB < g->K) {
+        ok = dyn_csr(g, &c);
+        if (ok) {
+            int q = greedy_clique(c.n, c.adj, c.start, c.deg);
+            if (q > g->LB) g->LB = q;
+        }
+        while (ok && g->seeded && !grow && g->LB < g->K && drop_class(g, &r, backup))
+            ;
+    }
+    if (ok) g->deleted = 0;
+
+    /* B&B: from the repaired colouring when it had to grow, or on demand */
+    if (ok && (grow || (prove && g->LB < g->K))) {
+        if (!c.adj) ok = dyn_csr(g, &c);
+        int* warm = ok ? (int*)malloc((c.n + 1) * sizeof(int)) : NULL;
+        int* kcol = ok ? (int*)malloc((c.n + 1) * sizeof(int)) : NULL;
+        ok = warm && kcol;
+        if (ok && c.n > 0) {
+            for (int i = 0; i < c.n; i++) warm[i] = g->color[c.old_of[i]];
+            int K, LB, UB0, opt, backend;
+            double t;
+            st = (algo == DYN_SEWELL ? sewell_solve_warm : furini_solve_warm)(
+                c.n, c.adj, c.start, c.deg, temps_max, progress, cancel, &K, kcol, &LB, &UB0,
+                &opt, out_nodes, out_cuts, &t, out_timeout, out_cancelled, &backend,
+                g->seeded ? g->K : 0, g->seeded ? warm : NULL, g->LB);
+            for (int i = 0; i < c.n; i++) g->color[c.old_of[i]] = kcol[i];
+            g->K = K;
+            if (LB > g->LB) g->LB = LB;
+            /* An exhausted search proves K even when the clique LB stays below */
+            if (st > 0 && (opt || !*out_timeout)) g->LB = K;
+            *out_searched = 1;
+        } else if (ok) {
+            g->K = g->LB = 0;
+        }
+        if (ok) g->seeded = 1;
+        free(warm); free(kcol);
+    }
+
+    dyn_csr_free(&c);
+    free(r.nb); free(r.vis); free(r.cmark); free(r.cnt); free(r.queue); free(r.list); free(backup);
+    if (!ok) return 0;
+
+    if (g->LB > g->K) g->LB = g->K;
+    memcpy(out_coloring, g->color, n * sizeof(int));
+    *out_K       = g->K;
+    *out_LB      = g->LB;
+    *out_optimal = g->K <= g->LB;
+    *out_time    = now_s() - t0;
+    return st < 0 ? st : 1;
+}
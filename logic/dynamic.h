@@ -0,0 +1,74 @@
+#pragma once
+#ifndef DYNAMIC_H
+#define DYNAMIC_H
+
+/*
+ * dynamic.h
+ * ─────────
+ * Persistent handle on a graph that changes between solves. The graph
+ * is kept as CSR with slack per row (a full row moves to the end of
+ * the pool with twice the room), so an edge update costs O(deg). Vertex
+ * ids are stable: a removed vertex goes dead and keeps its id.
+ *
+ * The handle also keeps the last colouring and a lower bound that the
+ * updates keep valid:
+ *   insertions : χ can only grow, so LB stands.
+ *   deletions  : removing an edge or a vertex lowers χ by at most 1,
+ *                so LB drops by one per deletion. A greedy clique of
+ *                the new graph then raises it again where it can.
+ *
+ * dyn_solve() first repairs the colouring locally. A vertex left
+ * uncoloured (new, or one end of an edge joining two equal colours)
+ * takes a free colour < K, else a Kempe swap frees one for it. After
+ * deletions it also tries to empty the smallest colour class the same
+ * way. The B&B (the engine's warm-started solve, from this colouring
+ * and LB) runs only when a repair had to open colour K+1, or when the
+ * caller asks for a proof.
+ */
+
+#include "coloring.h"
+
+#define DYN_SEWELL  0
+#define DYN_FURINI  1
+
+typedef struct DynGraph DynGraph;
+
+/* ── Handle from a CSR graph with sorted rows (copied); NULL on OOM ── */
+EXPORT DynGraph* dyn_new(int n, const int* adj, const int* start, const int* deg);
+EXPORT void      dyn_free(DynGraph* g);
+
+/* ── Vertex ids handed out so far, dead ones included ──────────────── */
+EXPORT int dyn_vertices(const DynGraph* g);
+
+/* ── Updates: 1 = done, 0 = nothing to do (edge present / absent,
+ * vertex already dead), -1 = bad vertex id or out of memory.
+ * dyn_add_vertex() returns the new id, or -1.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int dyn_add_edge(DynGraph* g, int u, int v);
+EXPORT int dyn_remove_edge(DynGraph* g, int u, int v);
+EXPORT int dyn_add_vertex(DynGraph* g);
+EXPORT int dyn_remove_vertex(DynGraph* g, int v);
+
+/* ── Adopt coloring[dyn_vertices()] (a proper colouring of the current
+ * graph, e.g. an earlier solve's) and a proven lower bound. Returns 0
+ * (handle unchanged) if the colouring is not proper.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int dyn_seed(DynGraph* g, const int* coloring, int LB);
+
+/* ── Colour the current graph ──────────────────────────────────────────
+ * algo: DYN_SEWELL / DYN_FURINI. The first solve without a seed is a
+ * full B&B. Afterwards the B&B only runs when the repair needs a new
+ * colour, or when prove is set and K > LB. out_coloring gets
+ * dyn_vertices() entries, -1 for dead vertices. *out_searched = 1 when
+ * the B&B ran; nodes, cuts and progress records come from it, and
+ * cancel (may be NULL) is its bb_cancel() token. Returns 0 on an
+ * unknown algo or allocation failure, BB_ERR_COLORS (outputs written)
+ * when the B&B could not run (see sewell_solve()), else 1.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int dyn_solve(DynGraph* g, int algo, int temps_max, int prove,
+                     ProgressRing* progress, const int* cancel,
+                     int* out_K, int* out_coloring, int* out_LB, int* out_optimal,
+                     long* out_nodes, long* out_cuts, double* out_time,
+                     int* out_timeout, int* out_cancelled, int* out_searched);
+
+#endif
@@ -0,0 +1,554 @@
+/*
+ * frac.c
+ * ──────
+ * Column generation for the fractional chromatic bound (see frac.h).
+ *
+ * The restricted master LP is solved by a revised primal simplex with
+ * an explicit dense basis inverse. Rows are the vertices; the start
+ * basis is the n singleton columns {v} (x = 1, feasible), and a
+ * surplus column -e_v lets row v go over-covered. B⁻¹ gets one
+ * elimination per pivot and is rebuilt from the basis every
+ * FRAC_REFACTOR pivots.
+ *
+ * Farley's bound needs α_y exactly (or from above): the exact pricing
+ * runs on integer weights ⌊y·FRAC_SCALE⌋, so over a set of at most
+ * npos positive vertices α_y < (α_int + npos) / FRAC_SCALE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "frac.h"
+
+#define FRAC_EPS          1e-9          /* reduced cost / pivot tolerance   */
+#define FRAC_SLACK        1e-7          /* bound = ⌈value - FRAC_SLACK⌉     */
+#define FRAC_REFACTOR     128           /* pivots between B⁻¹ rebuilds      */
+#define FRAC_EXACT_EVERY  16            /* exact pricing at least this often */
+#define FRAC_SCALE        1073741824.0  /* 2^30                             */
+#define FRAC_NONE         INT_MIN
+
+/* Basis column codes: ≥ 0 a priced column, else a surplus or a singleton */
+#define FRAC_SURPLUS(n, v)  (-1 - (v))
+#define FRAC_SINGLE(n, v)   (-1 - (n) - (v))
+
+static int    frac_depth = -1;
+static double frac_share = 0.05;
+
+EXPORT void bb_set_frac_depth(int depth) { frac_depth = depth < 0 ? -1 : depth; }
+int         bb_frac_depth(void)          { return frac_depth; }
+
+EXPORT void bb_set_frac_share(double share) {
+    frac_share = share < 0.0 ? 0.0 : share > 1.0 ? 1.0 : share;
+}
+double bb_frac_share(void) { return frac_share; }
+
+/* ── Pool ──────────────────────────────────────────────────────────── */
+
+void frac_pool_add(FracPool* p, const uint64_t* col) {
+    size_t w = (size_t)p->words;
+    if (!p->cap) return;
+    for (int i = 0; i < p->count; i++)
+        if (!memcmp(p->cols + i * w, col, w * sizeof(uint64_t))) return;
+    int slot;
+    if (p->count < p->cap) slot = p->count++;
+    else { slot = p->next; p->next = (p->next + 1) % p->cap; }
+    memcpy(p->cols + slot * w, col, w * sizeof(uint64_t));
+}
+
+void frac_pool_add_coloring(FracPool* p, int n, const int* col, int k) {
+    uint64_t* S = (uint64_t*)malloc((size_t)p->words * sizeof(uint64_t));
+    if (!S) return;
+    for (int c = 0; c < k; c++) {
+        int any = 0;
+        memset(S, 0, (size_t)p->words * sizeof(uint64_t));
+        for (int v = 0; v < n; v++)
+            if (col[v] == c) { S[v >> 6] |= 1ULL << (v & 63); any = 1; }
+        if (any) frac_pool_add(p, S);
+    }
+    free(S);
+}
+
+/* ── Exact maximum-weight independent set ──────────────────────────────
+ * Bit-parallel B&B in the BBMC mould, with the roles of edges and
+ * non-edges swapped: P is greedily covered by cliques of G (one AND per
+ * vertex), and an independent set inside the covered prefix takes at
+ * most one vertex per clique, hence at most the sum of their heaviest
+ * weights. Branching runs from the end of the cover.
+ * ─────────────────────────────────────────────────────────────────── */
+typedef struct {
+    const uint64_t* mat;
+    int            words;
+    const int64_t* w;
+    int64_t        best;
+    int*           best_set;
+    int            best_len;
+    int*           cur;
+    int            cur_len;
+    long           nodes;
+    long           max_nodes;
+    double         deadline;
+    const int*     cancel;
+    int            aborted;
+    Arena*         ws;
+} Mwis;
+
+static size_t mwis_ws_bytes(int n) {
+    size_t words = ((size_t)n + 63) >> 6;
+    size_t level = ARENA_PAD((size_t)n * sizeof(int)) + ARENA_PAD((size_t)n * sizeof(int64_t))
+                 + 3 * ARENA_PAD(words * sizeof(uint64_t));
+    return ARENA_PAD(words * sizeof(uint64_t)) + (size_t)(n + 2) * level;
+}
+
+static void mwis_expand(Mwis* m, uint64_t* P, int64_t cur) {
+    m->nodes++;
+    if ((m->max_nodes > 0 && m->nodes > m->max_nodes) ||
+        ((m->nodes & 1023) == 0 && ((m->deadline > 0.0 && now_s() > m->deadline) ||
+                                    bb_cancelled(m->cancel)))) {
+        m->aborted = 1;
+        return;
+    }
+    if (cur > m->best) {
+        m->best = cur;
+        m->best_len = m->cur_len;
+        memcpy(m->best_set, m->cur, m->cur_len * sizeof(int));
+    }
+
+    int    words = m->words;
+    size_t mark  = m->ws->top;
+    int    np    = bitrow_count(P, words);
+    int*      order = (int*)arena_push(m->ws, np * sizeof(int));
+    int64_t*  bound = (int64_t*)arena_push(m->ws, np * sizeof(int64_t));
+    uint64_t* U     = (uint64_t*)arena_push(m->ws, words * sizeof(uint64_t));
+    uint64_t* Q     = (uint64_t*)arena_push(m->ws, words * sizeof(uint64_t));
+    uint64_t* NP    = (uint64_t*)arena_push(m->ws, words * sizeof(uint64_t));
+    if (!order || !bound || !U || !Q || !NP) {
+        m->aborted = 1;
+        m->ws->top = mark;
+        return;
+    }
+
+    /* ── Clique cover of P in vertex order ─────────────────────────────
+     * bound[i]: closed cliques' heaviest weights, plus the heaviest of
+     * the current clique up to order[i].
+     * ─────────────────────────────────────────────────────────────── */
+    int     no = 0, w0 = 0;
+    int64_t closed = 0;
+    memcpy(U, P, words * sizeof(uint64_t));
+    while (w0 < words) {
+        int64_t cmax = 0;
+        memcpy(Q + w0, U + w0, (words - w0) * sizeof(uint64_t));
+        for (int w = w0; w < words; w++) {
+            while (Q[w]) {
+                int      b   = __builtin_ctzll(Q[w]);
+                int      v   = (w << 6) + b;
+                uint64_t bit = 1ULL << b;
+                const uint64_t* row = m->mat + (size_t)v * words;
+                U[w] &= ~bit;
+                Q[w] &= ~bit;
+                for (int x = w; x < words; x++) Q[x] &= row[x];
+                if (m->w[v] > cmax) cmax = m->w[v];
+                order[no] = v; bound[no] = closed + cmax; no++;
+            }
+        }
+        closed += cmax;
+        while (w0 < words && !U[w0]) w0++;
+    }
+
+    /* ── Branch from the end of the cover ── */
+    for (int i = no - 1; i >= 0 && !m->aborted; i--) {
+        if (cur + bound[i] <= m->best) break;
+        int v = order[i];
+        const uint64_t* row = m->mat + (size_t)v * words;
+        P[v >> 6] &= ~(1ULL << (v & 63));
+        uint64_t any = 0;
+        for (int w = 0; w < words; w++) any |= (NP[w] = P[w] & ~row[w]);
+
+        m->cur[m->cur_len++] = v;
+        if (any) mwis_expand(m, NP, cur + m->w[v]);
+        else if (cur + m->w[v] > m->best) {
+            m->best = cur + m->w[v];
+            m->best_len = m->cur_len;
+            memcpy(m->best_set, m->cur, m->cur_len * sizeof(int));
+        }
+        m->cur_len--;
+    }
+
+    m->ws->top = mark;
+}
+
+/* ── LP state ──────────────────────────────────────────────────────── */
+typedef struct {
+    int             n, words;
+    const uint64_t* mat;
+    uint64_t*       cols;       /* pool copy, then the columns priced here */
+    int             ncols, ccap;
+    int             priced0;    /* first column priced in this call       */
+    double*         Binv;       /* n × n, row r ↔ basis position r        */
+    double*         M;          /* refactor scratch, n × n                */
+    double*         xB;
+    double*         y;
+    double*         d;
+    int*            head;       /* column code at basis position r        */
+    int*            ord;        /* vertex scratch                         */
+    int*            mem;        /* members of one column                  */
+    int64_t*        w;          /* integer pricing weights                */
+    uint64_t*       S;
+    uint64_t*       F;
+    int*            cur;        /* MWIS stacks                            */
+    int*            set;
+    Arena           ws;
+} Lp;
+
+static void lp_free(Lp* L) {
+    free(L->cols); free(L->Binv); free(L->M); free(L->xB); free(L->y); free(L->d);
+    free(L->head); free(L->ord); free(L->mem); free(L->w); free(L->S); free(L->F);
+    free(L->cur); free(L->set);
+    arena_free(&L->ws);
+}
+
+static int lp_init(Lp* L, int n, const uint64_t* mat, int words, const FracPool* pool) {
+    memset(L, 0, sizeof(*L));
+    L->n = n; L->words = words; L->mat = mat;
+    L->ccap  = pool->count + n + 64;
+    L->cols  = (uint64_t*)malloc((size_t)L->ccap * words * sizeof(uint64_t));
+    L->Binv  = (double*)calloc((size_t)n * n, sizeof(double));
+    L->M     = (double*)malloc((size_t)n * n * sizeof(double));
+    L->xB    = (double*)malloc(n * sizeof(double));
+    L->y     = (double*)malloc(n * sizeof(double));
+    L->d     = (double*)malloc(n * sizeof(double));
+    L->head  = (int*)malloc(n * sizeof(int));
+    L->ord   = (int*)malloc(n * sizeof(int));
+    L->mem   = (int*)malloc(n * sizeof(int));
+    L->w     = (int64_t*)malloc(n * sizeof(int64_t));
+    L->S     = (uint64_t*)malloc(words * sizeof(uint64_t));
+    L->F     = (uint64_t*)malloc(words * sizeof(uint64_t));
+    L->cur   = (int*)malloc((n + 1) * sizeof(int));
+    L->set   = (int*)malloc((n + 1) * sizeof(int));
+    if (!L->cols || !L->Binv || !L->M || !L->xB || !L->y || !L->d || !L->head ||
+        !L->ord || !L->mem || !L->w || !L->S || !L->F || !L->cur || !L->set ||
+        !arena_init(&L->ws, mwis_ws_bytes(n)))
+        return 0;
+
+    memcpy(L->cols, pool->cols, (size_t)pool->count * words * sizeof(uint64_t));
+    L->ncols = L->priced0 = pool->count;
+    for (int r = 0; r < n; r++) {
+        L->Binv[(size_t)r * n + r] = 1.0;
+        L->xB[r]   = 1.0;
+        L->head[r] = FRAC_SINGLE(n, r);
+    }
+    return 1;
+}
+
+/* New column S; returns its code, FRAC_NONE when out of memory */
+static int lp_add_col(Lp* L, const uint64_t* S) {
+    size_t w = (size_t)L->words;
+    if (L->ncols == L->ccap) {
+        int cap = 2 * L->ccap;
+        uint64_t* c = (uint64_t*)realloc(L->cols, (size_t)cap * w * sizeof(uint64_t));
+        if (!c) return FRAC_NONE;
+        L->cols = c; L->ccap = cap;
+    }
+    memcpy(L->cols + (size_t)L->ncols * w, S, w * sizeof(uint64_t));
+    return L->ncols++;
+}
+
+/* Members of column j ≥ 0 into L->mem; returns how many */
+static int lp_members(const Lp* L, int j) {
+    const uint64_t* S = L->cols + (size_t)j * L->words;
+    int m = 0;
+    for (int w = 0; w < L->words; w++)
+        for (uint64_t b = S[w]; b; b &= b - 1) L->mem[m++] = (w << 6) + __builtin_ctzll(b);
+    return m;
+}
+
+/* d = B⁻¹ a_j */
+static void lp_ftran(Lp* L, int j, double* d) {
+    int n = L->n;
+    if (j >= 0) {
+        int m = lp_members(L, j);
+        for (int i = 0; i < n; i++) {
+            const double* r = L->Binv + (size_t)i * n;
+            double t = 0.0;
+            for (int k = 0; k < m; k++) t += r[L->mem[k]];
+            d[i] = t;
+        }
+    } else {
+        int surplus = j >= -n;
+        int v = surplus ? -1 - j : -1 - n - j;
+        for (int i = 0; i < n; i++) {
+            double b = L->Binv[(size_t)i * n + v];
+            d[i] = surplus ? -b : b;
+        }
+    }
+}
+
+/* ── B⁻¹ and x_B = B⁻¹·1 from the basis (Gauss-Jordan); 0 if singular */
+static int lp_refactor(Lp* L) {
+    int n = L->n;
+    double *M = L->M, *B = L->Binv;
+    memset(M, 0, (size_t)n * n * sizeof(double));
+    memset(B, 0, (size_t)n * n * sizeof(double));
+    for (int r = 0; r < n; r++) {
+        int j = L->head[r];
+        B[(size_t)r * n + r] = 1.0;
+        if (j >= 0) {
+            int m = lp_members(L, j);
+            for (int k = 0; k < m; k++) M[(size_t)L->mem[k] * n + r] = 1.0;
+        } else if (j >= -n) M[(size_t)(-1 - j) * n + r] = -1.0;
+        else                M[(size_t)(-1 - n - j) * n + r] = 1.0;
+    }
+    for (int c = 0; c < n; c++) {
+        int p = c;
+        for (int i = c + 1; i < n; i++)
+            if (__builtin_fabs(M[(size_t)i * n + c]) > __builtin_fabs(M[(size_t)p * n + c])) p = i;
+        if (__builtin_fabs(M[(size_t)p * n + c]) < 1e-12) return 0;
+        if (p != c)
+            for (int k = 0; k < n; k++) {
+                double t = M[(size_t)p * n + k]; M[(size_t)p * n + k] = M[(size_t)c * n + k]; M[(size_t)c * n + k] = t;
+                t = B[(size_t)p * n + k]; B[(size_t)p * n + k] = B[(size_t)c * n + k]; B[(size_t)c * n + k] = t;
+            }
+        double  inv = 1.0 / M[(size_t)c * n + c];
+        double *mc = M + (size_t)c * n, *bc = B + (size_t)c * n;
+        for (int k = c; k < n; k++) mc[k] *= inv;
+        for (int k = 0; k < n; k++) bc[k] *= inv;
+        for (int i = 0; i < n; i++) {
+            double f = M[(size_t)i * n + c];
+            if (i == c || f == 0.0) continue;
+            double *mi = M + (size_t)i * n, *bi = B + (size_t)i * n;
+            for (int k = c; k < n; k++) mi[k] -= f * mc[k];
+            for (int k = 0; k < n; k++) bi[k] -= f * bc[k];
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        double t = 0.0;
+        for (int k = 0; k < n; k++) t += B[(size_t)i * n + k];
+        L->xB[i] = t;
+    }
+    return 1;
+}
+
+/* y = c_B B⁻¹ (every column costs 1, surpluses 0) */
+static void lp_duals(Lp* L) {
+    int n = L->n;
+    memset(L->y, 0, n * sizeof(double));
+    for (int r = 0; r < n; r++) {
+        int j = L->head[r];
+        if (j < 0 && j >= -n) continue;
+        const double* row = L->Binv + (size_t)r * n;
+        for (int v = 0; v < n; v++) L->y[v] += row[v];
+    }
+}
+
+static void lp_pivot(Lp* L, int r, int enter) {
+    int     n  = L->n;
+    double* d  = L->d;
+    double* pr = L->Binv + (size_t)r * n;
+    double  inv = 1.0 / d[r];
+    for (int v = 0; v < n; v++) pr[v] *= inv;
+    double xr = L->xB[r] * inv;
+    for (int i = 0; i < n; i++) {
+        double f = d[i];
+        if (i == r || f == 0.0) continue;
+        double* ri = L->Binv + (size_t)i * n;
+        for (int v = 0; v < n; v++) ri[v] -= f * pr[v];
+        L->xB[i] -= f * xr;
+    }
+    L->xB[r]   = xr;
+    L->head[r] = enter;
+}
+
+/* ── Greedy heavy independent set under y ──────────────────────────────
+ * Heaviest first, then swaps (add u, drop its neighbours in S) while
+ * one gains. Writes S; returns its weight.
+ * ─────────────────────────────────────────────────────────────────── */
+static double greedy_is(Lp* L, uint64_t* S) {
+    int n = L->n, words = L->words, m = 0;
+    const double* y = L->y;
+    for (int v = 0; v < n; v++) if (y[v] > FRAC_EPS) L->ord[m++] = v;
+    /* Shell sort by y descending (no context pointer for qsort in C99) */
+    for (int gap = m / 2; gap > 0; gap /= 2)
+        for (int i = gap; i < m; i++) {
+            int v = L->ord[i], j = i;
+            for (; j >= gap && y[L->ord[j - gap]] < y[v]; j -= gap) L->ord[j] = L->ord[j - gap];
+            L->ord[j] = v;
+        }
+
+    double sum = 0.0;
+    memset(S, 0, words * sizeof(uint64_t));
+    memset(L->F, 0, words * sizeof(uint64_t));
+    for (int i = 0; i < m; i++) {
+        int v = L->ord[i];
+        if (bitrow_has(L->F, v)) continue;
+        const uint64_t* row = L->mat + (size_t)v * words;
+        S[v >> 6] |= 1ULL << (v & 63);
+        for (int w = 0; w < words; w++) L->F[w] |= row[w];
+        sum += y[v];
+    }
+
+    for (int pass = 0, improved = 1; pass < 3 && improved; pass++) {
+        improved = 0;
+        for (int i = 0; i < m; i++) {
+            int u = L->ord[i];
+            if (bitrow_has(S, u)) continue;
+            const uint64_t* row = L->mat + (size_t)u * words;
+            double lost = 0.0;
+            for (int w = 0; w < words; w++)
+                for (uint64_t b = S[w] & row[w]; b; b &= b - 1) lost += y[(w << 6) + __builtin_ctzll(b)];
+            if (y[u] <= lost + FRAC_EPS) continue;
+            for (int w = 0; w < words; w++) S[w] &= ~row[w];
+            S[u >> 6] |= 1ULL << (u & 63);
+            sum += y[u] - lost;
+            improved = 1;
+        }
+    }
+    return sum;
+}
+
+/* ── Exact pricing on ⌊y⁺·FRAC_SCALE⌋, from the set in S ───────────────
+ * Raises *best by Farley's bound when the search completes. Leaves the
+ * heaviest set found in S and returns its y-weight.
+ * ─────────────────────────────────────────────────────────────────── */
+static double exact_is(Lp* L, uint64_t* S, long max_nodes, double deadline,
+                       const int* cancel, double* best) {
+    int n = L->n, words = L->words, npos = 0;
+    double ysum = 0.0;
+    size_t mark = L->ws.top;
+    uint64_t* P = (uint64_t*)arena_push_zero(&L->ws, words * sizeof(uint64_t));
+    if (!P) return 0.0;
+    for (int v = 0; v < n; v++) {
+        double y = L->y[v] > 0.0 ? L->y[v] : 0.0;
+        L->w[v] = (int64_t)(y * FRAC_SCALE);
+        ysum += y;
+        if (L->w[v] > 0) { P[v >> 6] |= 1ULL << (v & 63); npos++; }
+    }
+
+    Mwis m;
+    memset(&m, 0, sizeof(m));
+    m.mat = L->mat; m.words = words; m.w = L->w;
+    m.best_set = L->set; m.cur = L->cur;
+    m.max_nodes = max_nodes; m.deadline = deadline; m.cancel = cancel; m.ws = &L->ws;
+    for (int w = 0; w < words; w++)
+        for (uint64_t b = S[w]; b; b &= b - 1) {
+            int v = (w << 6) + __builtin_ctzll(b);
+            m.best += L->w[v];
+            m.best_set[m.best_len++] = v;
+        }
+    mwis_expand(&m, P, 0);
+    L->ws.top = mark;
+
+    if (!m.aborted) {
+        double alpha = ((double)m.best + npos) / FRAC_SCALE;
+        if (alpha > 0.0 && ysum / alpha > *best) *best = ysum / alpha;
+    }
+    double sum = 0.0;
+    memset(S, 0, words * sizeof(uint64_t));
+    for (int i = 0; i < m.best_len; i++) {
+        int v = m.best_set[i];
+        S[v >> 6] |= 1ULL << (v & 63);
+        sum += L->y[v];
+    }
+    return sum;
+}
+
+/* ── Entering column, or FRAC_NONE (optimal, or pricing gave up) ───── */
+static int lp_price(Lp* L, long iter, long mwis_nodes, double deadline, const int* cancel,
+                    double* best) {
+    int n = L->n;
+    const double* y = L->y;
+
+    int jv = -1;
+    double low = -FRAC_EPS;
+    for (int v = 0; v < n; v++) if (y[v] < low) { low = y[v]; jv = v; }
+    if (jv >= 0) return FRAC_SURPLUS(n, jv);
+
+    int jb = FRAC_NONE;
+    low = -FRAC_EPS;
+    for (int j = 0; j < L->ncols; j++) {
+        int    m  = lp_members(L, j);
+        double rc = 1.0;
+        for (int k = 0; k < m; k++) rc -= y[L->mem[k]];
+        if (rc < low) { low = rc; jb = j; }
+    }
+
+    double gw = greedy_is(L, L->S);
+    if (jb != FRAC_NONE && iter % FRAC_EXACT_EVERY) return jb;
+    if (gw > 1.0 + FRAC_EPS && iter % FRAC_EXACT_EVERY) return lp_add_col(L, L->S);
+
+    /* Exact: certifies α_y, and prices the heaviest set found */
+    double ew = exact_is(L, L->S, mwis_nodes, deadline, cancel, best);
+    if (ew > 1.0 + FRAC_EPS) return lp_add_col(L, L->S);
+    if (jb != FRAC_NONE) return jb;
+    return gw > 1.0 + FRAC_EPS ? lp_add_col(L, L->S) : FRAC_NONE;
+}
+
+static int bound_of(double value) {
+    double v = value - FRAC_SLACK;
+    int q = (int)v;
+    return q < v ? q + 1 : q;
+}
+
+int frac_lb(int n, const uint64_t* mat, int words, FracPool* pool,
+            int lb, int target, long max_pivots, long mwis_nodes,
+            double deadline, const int* cancel, double* out_value) {
+    if (out_value) *out_value = 0.0;
+    if (n <= 0 || n > FRAC_MAX_N || lb >= target) return lb;
+
+    Lp L;
+    if (!lp_init(&L, n, mat, words, pool)) { lp_free(&L); return lb; }
+    double best = 0.0;
+    for (long iter = 1;; iter++) {
+        if (bound_of(best) >= target) break;
+        if (max_pivots > 0 && iter > max_pivots) break;
+        if ((deadline > 0.0 && now_s() > deadline) || bb_cancelled(cancel)) break;
+        if (iter % FRAC_REFACTOR == 0 && !lp_refactor(&L)) break;
+
+        lp_duals(&L);
+        int enter = lp_price(&L, iter, mwis_nodes, deadline, cancel, &best);
+        if (enter == FRAC_NONE) break;
+
+        /* Ratio test, ties to the largest pivot */
+        lp_ftran(&L, enter, L.d);
+        int    r = -1;
+        double rmin = 0.0, dmax = 0.0;
+        for (int i = 0; i < n; i++) {
+            if (L.d[i] <= FRAC_EPS) continue;
+            double x = L.xB[i] > 0.0 ? L.xB[i] : 0.0;
+            double ratio = x / L.d[i];
+            if (r < 0 || ratio < rmin - 1e-12) { r = i; rmin = ratio; dmax = L.d[i]; }
+            else if (ratio <= rmin + 1e-12 && L.d[i] > dmax) { r = i; dmax = L.d[i]; }
+        }
+        if (r < 0) break;
+        lp_pivot(&L, r, enter);
+    }
+
+    for (int j = L.priced0; j < L.ncols; j++)
+        frac_pool_add(pool, L.cols + (size_t)j * words);
+    lp_free(&L);
+
+    if (out_value) *out_value = best;
+    int q = bound_of(best);
+    return q > lb ? q : lb;
+}
+
+int frac_root_lb(int n, const int* adj, const int* start, const int* deg,
+                 const uint64_t* amat, int awords, const int* coloring,
+                 int lb, int ub, double time_limit, const int* cancel) {
+    if (n <= 0 || n > FRAC_MAX_N || lb >= ub || time_limit <= 0.0) return lb;
+    int words = awords;
+    uint64_t* own = NULL;
+    if (!amat) {
+        own = adjmat_build(n, adj, start, deg, &words);
+        if (!own) return lb;
+        amat = own;
+    }
+    uint64_t* mem = (uint64_t*)malloc(frac_pool_bytes(words, FRAC_POOL_COLS));
+    if (mem) {
+        FracPool pool;
+        frac_pool_init(&pool, mem, words, FRAC_POOL_COLS);
+        frac_pool_add_coloring(&pool, n, coloring, ub);
+        lb = frac_lb(n, amat, words, &pool, lb, ub, 0, 0, now_s() + time_limit, cancel, NULL);
+    }
+    free(mem);
+    free(own);
+    return lb;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#ifndef FRAC_H
+#define FRAC_H
+
+/*
+ * frac.h
+ * ──────
+ * Fractional chromatic lower bound (Mehrotra & Trick, 1996): the set
+ * covering LP over the independent sets S of G,
+ *
+ *     min Σ x_S   s.t.   Σ_{S ∋ v} x_S ≥ 1  (v ∈ V),   x ≥ 0,
+ *
+ * solved by column generation. Its optimum χ_f(G) lies between ω(G)
+ * and χ(G), and on graphs like myciel* and DSJC well above ω. Every
+ * dual y the LP passes through also gives Farley's bound
+ * Σ y⁺ / α_y⁺(G) ≤ χ_f(G) (α_y: heaviest independent set under
+ * weights y), so a run cut short by its budget still leaves a bound.
+ *
+ * Pricing looks for an independent set of dual weight > 1: first among
+ * the pooled columns, then a greedy set with one swap pass, then an
+ * exact bit-parallel B&B (weighted clique-cover bound), which is also
+ * what certifies α_y. Columns carry over between calls in a FracPool:
+ * the root LP starts from the incumbent's colour classes, and Furini's
+ * node LPs (bb_set_frac_depth()) from the columns of earlier nodes.
+ */
+
+#include "coloring.h"
+
+/* ── Largest graph the dense LP basis is kept for ──────────────────── */
+#define FRAC_MAX_N      512
+
+/* ── Columns kept by a pool; the oldest is replaced once full ──────── */
+#define FRAC_POOL_COLS  512
+
+/* ── Column pool: independent sets as bit rows of `words` ──────────── */
+typedef struct {
+    int       words;
+    int       count;
+    int       cap;
+    int       next;         /* slot replaced next once count == cap     */
+    uint64_t* cols;         /* cap rows                                 */
+} FracPool;
+
+static inline size_t frac_pool_bytes(int words, int cap) {
+    return ARENA_PAD((size_t)cap * words * sizeof(uint64_t));
+}
+
+static inline void frac_pool_init(FracPool* p, uint64_t* mem, int words, int cap) {
+    p->words = words; p->count = 0; p->cap = cap; p->next = 0; p->cols = mem;
+}
+
+/* Adds col unless the pool already holds it */
+void frac_pool_add(FracPool* p, const uint64_t* col);
+
+/* The colour classes of col[0..n) (colours < k) as columns */
+void frac_pool_add_coloring(FracPool* p, int n, const int* col, int k);
+
+/* ── Lower bound on χ of a bit-matrix graph ────────────────────────────
+ * mat: n ≤ FRAC_MAX_N rows of `words` uint64_t, symmetric, loop-free.
+ * pool (words-long rows over the same vertices) seeds the LP and gets
+ * the columns it prices. Stops once the bound reaches target, after
+ * max_pivots simplex pivots, or when an exact pricing needs more than
+ * mwis_nodes B&B nodes (≤ 0: no cap on either), at the deadline
+ * (≤ 0: none) or on bb_cancel() of cancel (may be NULL). Returns
+ * max(lb, ⌈bound⌉); *out_value (may be NULL) gets the best fractional
+ * bound.
+ * ─────────────────────────────────────────────────────────────────── */
+int frac_lb(int n, const uint64_t* mat, int words, FracPool* pool,
+            int lb, int target, long max_pivots, long mwis_nodes,
+            double deadline, const int* cancel, double* out_value);
+
+/* ── Root bound for initial_bounds(): frac_lb() on G within time_limit
+ * seconds, seeded with coloring's ub classes. amat may be NULL (the
+ * matrix is then built here); skipped above FRAC_MAX_N vertices.
+ * ─────────────────────────────────────────────────────────────────── */
+int frac_root_lb(int n, const int* adj, const int* start, const int* deg,
+                 const uint64_t* amat, int awords, const int* coloring,
+                 int lb, int ub, double time_limit, const int* cancel);
+
+/* ── Where the LP bound runs (default -1) ──────────────────────────────
+ * depth < 0: never; 0: at the root of every engine (initial_bounds());
+ * d > 0: also at Furini nodes of B&B depth 1..d where the reduced-graph
+ * clique does not prune, on the reduced graph R of the node.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT void bb_set_frac_depth(int depth);
+int         bb_frac_depth(void);
+
+/* ── Its time budget: share · temps_max at the root, and as much again
+ * per search thread for the node LPs (default 0.05)
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT void bb_set_frac_share(double share);
+double      bb_frac_share(void);
+
+#endif
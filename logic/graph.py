@@ -1,16 +1,43 @@
 """
 logic/graph.py
 ──────────────
-DIMACS .col parser and graph utility functions.
+DIMACS .col parser, binary .csr format and graph utility functions.
 Returns data in CSR (Compressed Sparse Row) format for direct C interop.
+
+parse_dimacs() runs the native loader (logic/loader.c, from the solver's
+shared library) when it is available and falls back to pure Python.
+
+Binary .csr layout (little-endian): 32-byte header
+    "GCSR" · u32 version · u32 n · u32 flags (0) · u64 entries · u64 m
+followed by int32 start[n], int32 deg[n], int32 adj_flat[entries].
+load_graph() memory-maps it, so reloading a saved graph costs no parsing.
 """
 
+import ctypes
+import mmap
+import os
+import struct
+import sys
+from array import array
 from collections import defaultdict
 
+_CSR_HEADER  = struct.Struct("<4sIIIQQ")
+_CSR_MAGIC   = b"GCSR"
+_CSR_VERSION = 1
+
+
+def _native():
+    """The solver's shared library, or None when it cannot be built."""
+    try:
+        from logic.solver import get_lib
+        return get_lib()
+    except Exception:
+        return None
+
 
 # ── DIMACS parser ─────────────────────────────────────────────────────────
 
-def parse_dimacs(content: bytes) -> dict:
+def parse_dimacs(content: bytes, arrays: bool = False) -> dict:
     """
     Parse a DIMACS .col file.
 
@@ -23,7 +50,18 @@ def parse_dimacs(content: bytes) -> dict:
         adj_flat : list[int]     – CSR flat adjacency
         start    : list[int]     – CSR start indices
         deg      : list[int]     – degree of each vertex
+
+    With arrays=True (requires numpy) adj_flat / start / deg are
+    numpy.int32 arrays built without per-edge Python sets, ready for
+    the solver's zero-copy hand-off, and voisins[u] are views into
+    adj_flat.
     """
+    lib = _native()
+    if lib is not None:
+        return _graph_dict(*_parse_dimacs_native(lib, content, len(content)), arrays)
+    if arrays:
+        return _parse_dimacs_arrays(content)
+
     n = 0
     adj: dict[int, set] = defaultdict(set)
 
@@ -63,3 +101,177 @@ def parse_dimacs(content: bytes) -> dict:
         "start":    start,
         "deg":      deg,
     }
+
+
+def _parse_dimacs_arrays(content: bytes) -> dict:
+    import numpy as np
+
+    n = 0
+    us, vs = array("i"), array("i")
+    for raw in content.splitlines():
+        line = raw.strip()
+        if not line or line[:1] == b'c':
+            continue
+        parts = line.split()
+        if line[:1] == b'p' and len(parts) >= 3:
+            n = int(parts[2])
+        elif line[:1] == b'e' and len(parts) >= 3:
+            us.append(int(parts[1]) - 1)
+            vs.append(int(parts[2]) - 1)
+
+    if n == 0:
+        raise ValueError("No vertices found – check the DIMACS file format.")
+
+    # Both directions, drop out-of-range ids, then sort + dedupe as u*n+v
+    u = np.array(us, dtype=np.int32)
+    v = np.array(vs, dtype=np.int32)
+    rows = np.concatenate([u, v]).astype(np.int64)
+    cols = np.concatenate([v, u]).astype(np.int64)
+    keep = (rows >= 0) & (rows < n) & (cols >= 0) & (cols < n)
+    keys = np.unique(rows[keep] * n + cols[keep])
+
+    adj_flat = (keys % n).astype(np.int32)
+    deg      = np.bincount(keys // n, minlength=n).astype(np.int32)
+    start    = np.zeros(n, dtype=np.int32)
+    start[1:] = np.cumsum(deg[:-1])
+    return _graph_dict(n, adj_flat, start, deg, True)
+
+
+def _parse_dimacs_native(lib, buf, length: int):
+    """C loader: (n, adj_flat, start, deg) as array('i') buffers."""
+    if isinstance(buf, bytes):
+        ptr = ctypes.c_char_p(buf)
+    else:                                   # writable buffer: mmap, bytearray
+        ptr = (ctypes.c_char * length).from_buffer(buf)
+
+    n, edges = ctypes.c_int(), ctypes.c_long()
+    rc = lib.dimacs_scan(ptr, length, ctypes.byref(n), ctypes.byref(edges))
+    if rc < 0:
+        raise ValueError(f"Malformed DIMACS line {-rc}.")
+    if rc == 0:
+        raise ValueError("No vertices found – check the DIMACS file format.")
+
+    adj   = array("i", [0]) * (2 * edges.value)
+    start = array("i", [0]) * n.value
+    deg   = array("i", [0]) * n.value
+    used = lib.dimacs_csr(ptr, length, n, edges,
+                          _c_ints(adj), _c_ints(start), _c_ints(deg))
+    del adj[used:]
+    return n.value, adj, start, deg
+
+
+def _c_ints(buf):
+    return (ctypes.c_int * len(buf)).from_buffer(buf)
+
+
+def _graph_dict(n: int, adj_flat, start, deg, arrays: bool) -> dict:
+    """parse_dimacs() result from CSR buffers (lists, or numpy with arrays=True)."""
+    if arrays:
+        import numpy as np
+        adj_flat = np.asarray(adj_flat, dtype=np.int32)
+        start    = np.asarray(start, dtype=np.int32)
+        deg      = np.asarray(deg, dtype=np.int32)
+        voisins  = np.split(adj_flat, start[1:]) if n else []
+    else:
+        adj_flat, start, deg = _as_list(adj_flat), _as_list(start), _as_list(deg)
+        voisins  = [adj_flat[start[i]:start[i] + deg[i]] for i in range(n)]
+
+    m = len(adj_flat) // 2
+    density = m / (n * (n - 1) / 2) * 100 if n > 1 else 0.0
+
+    return {
+        "n":        n,
+        "m":        m,
+        "density":  round(density, 2),
+        "voisins":  voisins,
+        "adj_flat": adj_flat,
+        "start":    start,
+        "deg":      deg,
+    }
+
+
+def _as_list(seq) -> list:
+    return seq if isinstance(seq, list) else seq.tolist()
+
+
+# ── Binary CSR (.csr) ─────────────────────────────────────────────────────
+
+def to_csr_bytes(graph_data: dict) -> bytes:
+    """Serialise graph_data to the binary .csr layout (see module doc)."""
+    n = graph_data["n"]
+    parts = [array("i", graph_data[k]) for k in ("start", "deg", "adj_flat")]
+    if sys.byteorder != "little":
+        for a in parts:
+            a.byteswap()
+    header = _CSR_HEADER.pack(_CSR_MAGIC, _CSR_VERSION, n, 0,
+                              len(parts[2]), graph_data["m"])
+    return header + b"".join(a.tobytes() for a in parts)
+
+
+def save_csr(graph_data: dict, path: str) -> None:
+    with open(path, "wb") as f:
+        f.write(to_csr_bytes(graph_data))
+
+
+def parse_csr(buf, arrays: bool = False) -> dict:
+    """
+    Graph from a binary .csr image (bytes, mmap, …). With arrays=True
+    and a writable buffer the numpy arrays alias buf directly.
+    """
+    if len(buf) < _CSR_HEADER.size:
+        raise ValueError("Truncated .csr header.")
+    magic, version, n, _flags, entries, _m = _CSR_HEADER.unpack_from(buf, 0)
+    if magic != _CSR_MAGIC or version != _CSR_VERSION:
+        raise ValueError("Not a .csr graph file (bad magic or version).")
+    if n <= 0 or len(buf) != _CSR_HEADER.size + 4 * (2 * n + entries):
+        raise ValueError("Corrupt .csr file (size does not match header).")
+
+    off = _CSR_HEADER.size
+    spans = [(off, n), (off + 4 * n, n), (off + 8 * n, entries)]
+    if arrays and sys.byteorder == "little":
+        import numpy as np
+        start, deg, adj = (np.frombuffer(buf, dtype=np.int32, count=c, offset=o)
+                           for o, c in spans)
+    else:
+        start, deg, adj = (array("i", bytes(buf[o:o + 4 * c])) for o, c in spans)
+        if sys.byteorder != "little":
+            for a in (start, deg, adj):
+                a.byteswap()
+
+    lib = _native()
+    if lib is not None and not lib.csr_check(n, entries, _as_c_int_arg(adj),
+                                             _as_c_int_arg(start), _as_c_int_arg(deg)):
+        raise ValueError("Corrupt .csr file (invalid adjacency rows).")
+    return _graph_dict(n, adj, start, deg, arrays)
+
+
+def _as_c_int_arg(buf):
+    if isinstance(buf, array):
+        return _c_ints(buf)
+    return buf.ctypes.data_as(ctypes.POINTER(ctypes.c_int))
+
+
+def load_graph(path: str, arrays: bool = False) -> dict:
+    """
+    Load a .csr (memory-mapped) or DIMACS .col file. DIMACS text is
+    mapped and parsed in place by the native loader when available.
+    """
+    with open(path, "rb") as f:
+        size = os.fstat(f.fileno()).st_size
+        if size == 0:
+            raise ValueError("Empty graph file.")
+        mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_COPY)
+
+    if path.lower().endswith(".csr"):
+        g = parse_csr(mm, arrays)
+        if not arrays:
+            mm.close()                      # numpy views keep mm alive
+        return g
+
+    try:
+        lib = _native()
+        if lib is not None:
+            return _graph_dict(*_parse_dimacs_native(lib, mm, size), arrays)
+        return parse_dimacs(mm[:], arrays)
+    finally:
+        mm.close()
@@ -3,19 +3,37 @@
  * ─────────────
  * greedy_clique : greedy maximum clique (lower bound for χ)
  * dsatur        : DSATUR colouring heuristic (upper bound for χ)
+ *
+ * initial_bounds() seeds the exact max_clique() (clique.c) with them.
  */
 
 #include <stdlib.h>
 #include <string.h>
 #include "coloring.h"
+#include "heuristics.h"
+#include "clique.h"
+#include "frac.h"
 
-/* ── Insertion-sort an int array by key[arr[i]] descending ─────────── */
-static void isort_desc(int* arr, int len, const int* key) {
-    for (int i = 1; i < len; i++) {
-        int val = arr[i], j = i - 1;
-        while (j >= 0 && key[arr[j]] < key[val]) { arr[j+1] = arr[j]; j--; }
-        arr[j+1] = val;
-    }
+/* ── Stable counting sort by key descending ────────────────────────────
+ * cnt[max_key - k + 1] counts key k, so after the prefix sum
+ * cnt[max_key - k] is the first output slot of key k.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT void csort_desc(int* arr, int len, const int* key, int max_key,
+                       int* scratch) {
+    int* cnt = scratch;
+    int* out = scratch + max_key + 2;
+    memset(cnt, 0, (size_t)(max_key + 2) * sizeof(int));
+    for (int i = 0; i < len; i++) cnt[max_key - key[arr[i]] + 1]++;
+    for (int k = 1; k <= max_key + 1; k++) cnt[k] += cnt[k - 1];
+    for (int i = 0; i < len; i++) out[cnt[max_key - key[arr[i]]]++] = arr[i];
+    memcpy(arr, out, (size_t)len * sizeof(int));
+}
+
+/* Largest key[i] over i < n (0 when n ≤ 0) */
+static int max_key_of(const int* key, int n) {
+    int m = 0;
+    for (int i = 0; i < n; i++) if (key[i] > m) m = key[i];
+    return m;
 }
 
 /* ── Greedy max clique ──────────────────────────────────────────────────
@@ -25,12 +43,17 @@ static void isort_desc(int* arr, int len, const int* key) {
 EXPORT int greedy_clique(int n, const int* adj, const int* start, const int* deg) {
     if (n <= 0) return 0;
 
-    int* order = (int*)malloc(n * sizeof(int));
-    int* clique = (int*)malloc(n * sizeof(int));
-    if (!order || !clique) { free(order); free(clique); return 1; }
+    int  max_deg = max_key_of(deg, n);
+    int* order   = (int*)malloc(n * sizeof(int));
+    int* clique  = (int*)malloc(n * sizeof(int));
+    int* scratch = (int*)malloc(CSORT_SCRATCH(n, max_deg) * sizeof(int));
+    if (!order || !clique || !scratch) {
+        free(order); free(clique); free(scratch); return 1;
+    }
 
     for (int i = 0; i < n; i++) order[i] = i;
-    isort_desc(order, n, deg);
+    csort_desc(order, n, deg, max_deg, scratch);
+    free(scratch);
 
     int clique_sz = 0;
     for (int i = 0; i < n; i++) {
@@ -45,48 +68,398 @@ EXPORT int greedy_clique(int n, const int* adj, const int* start, const int* deg
     return result;
 }
 
+/* ── Greedy max clique on the adjacency bit-matrix ─────────────────────
+ * Same greedy order as greedy_clique(); the candidate set is kept as a
+ * bitset and narrowed with one word-wise AND per accepted vertex.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int greedy_clique_mat(int n, const int* deg,
+                             const uint64_t* amat, int awords) {
+    if (n <= 0) return 0;
+
+    int       max_deg = max_key_of(deg, n);
+    int*      order   = (int*)malloc(n * sizeof(int));
+    uint64_t* cand    = (uint64_t*)malloc(awords * sizeof(uint64_t));
+    int*      scratch = (int*)malloc(CSORT_SCRATCH(n, max_deg) * sizeof(int));
+    if (!order || !cand || !scratch) {
+        free(order); free(cand); free(scratch); return 1;
+    }
+
+    for (int i = 0; i < n; i++) order[i] = i;
+    csort_desc(order, n, deg, max_deg, scratch);
+    free(scratch);
+    memset(cand, 0xff, awords * sizeof(uint64_t));
+
+    int clique_sz = 0;
+    for (int i = 0; i < n; i++) {
+        int v = order[i];
+        if (!((cand[v >> 6] >> (v & 63)) & 1ULL)) continue;
+        const uint64_t* row = amat + (size_t)v * awords;
+        for (int w = 0; w < awords; w++) cand[w] &= row[w];
+        clique_sz++;
+    }
+
+    free(order); free(cand);
+    return clique_sz;
+}
+
+/* ── Widen the ccnt / cset rows and DSAT levels of s to ncolors colors
+ * (at most BB_MAX_COLORS; 0 when s is already there or on failure) */
+static int grow_colors(BBState* s, int ncolors) {
+    if (ncolors > BB_MAX_COLORS) ncolors = BB_MAX_COLORS;
+    if (ncolors <= s->ncolors) return 0;
+    size_t el = s->ix == BB_IX32W ? sizeof(int) : sizeof(uint16_t);
+    uint8_t* cc = (uint8_t*)aligned_calloc((size_t)s->n * ncolors * el);
+    if (!cc) return 0;
+    for (int v = 0; v < s->n; v++)
+        memcpy(cc + (size_t)v * ncolors * el, (uint8_t*)s->ccnt + (size_t)v * s->ncolors * el,
+               s->ncolors * el);
+    aligned_free(s->ccnt);
+    s->ccnt = cc; s->ncolors = ncolors;
+
+    int cw = cs_words(ncolors);
+    if (cw != s->cwords) {
+        ColorSet* cs = (ColorSet*)aligned_calloc((size_t)s->n * cw * sizeof(ColorSet));
+        if (!cs) return 0;
+        for (int v = 0; v < s->n; v++)
+            memcpy(cs + (size_t)v * cw, s->cset + (size_t)v * s->cwords,
+                   s->cwords * sizeof(ColorSet));
+        aligned_free(s->cset);
+        s->cset = cs; s->cwords = cw;
+    }
+
+    /* Levels are stored contiguously: new ones are appended zeroed */
+    int old = s->qlevels, lv = ncolors + 1;
+    uint64_t* qb = (uint64_t*)realloc(s->qbits, (size_t)lv * s->qwords * sizeof(uint64_t));
+    if (qb) s->qbits = qb;
+    uint64_t* qs = (uint64_t*)realloc(s->qsumm, (size_t)lv * s->qsw * sizeof(uint64_t));
+    if (qs) s->qsumm = qs;
+    int* qc = (int*)realloc(s->qcount, lv * sizeof(int));
+    if (qc) s->qcount = qc;
+    if (!qb || !qs || !qc) return 0;
+    memset(s->qbits + (size_t)old * s->qwords, 0, (size_t)(lv - old) * s->qwords * sizeof(uint64_t));
+    memset(s->qsumm + (size_t)old * s->qsw,    0, (size_t)(lv - old) * s->qsw * sizeof(uint64_t));
+    memset(s->qcount + old, 0, (lv - old) * sizeof(int));
+    s->qlevels = lv;
+    return 1;
+}
+
+/* ── First-fit colouring of the vertices with col[v] < 0, by index ───
+ * Returns the number of colours of the completed col, 0 on failure. */
+static int first_fit_rest(int n, const int* adj, const int* start, const int* deg,
+                          int* col) {
+    int  max_deg = max_key_of(deg, n);
+    int* seen    = (int*)malloc((max_deg + 2) * sizeof(int));
+    if (!seen) return 0;
+    for (int c = 0; c <= max_deg + 1; c++) seen[c] = -1;
+    int k = 0;
+    for (int v = 0; v < n; v++) {
+        if (col[v] < 0) {
+            for (int j = start[v]; j < start[v] + deg[v]; j++) {
+                int c = col[adj[j]];
+                if (c >= 0 && c <= deg[v]) seen[c] = v;
+            }
+            int c = 0;
+            while (seen[c] == v) c++;
+            col[v] = c;
+        }
+        if (col[v] + 1 > k) k = col[v] + 1;
+    }
+    free(seen);
+    return k;
+}
+
 /* ── DSATUR heuristic colouring ────────────────────────────────────────
  * Returns χ_DSATUR (valid upper bound for χ(G)).
  * Writes the colouring into out_coloring[0..n-1].
+ * Shares colorier() with the B&B engines; the number of colours is not
+ * known in advance, so the ccnt rows start narrow and double on demand.
+ * Past BB_MAX_COLORS (the record width) the remaining vertices are
+ * coloured first-fit instead.
  * ─────────────────────────────────────────────────────────────────── */
 EXPORT int dsatur(int n, const int* adj, const int* start, const int* deg,
                   int* out_coloring) {
     if (n <= 0) return 0;
 
-    for (int i = 0; i < n; i++) out_coloring[i] = -1;
-
-    ColorSet* cset = (ColorSet*)calloc(n, sizeof(ColorSet));
-    int*      dsat = (int*)calloc(n, sizeof(int));
-    if (!cset || !dsat) { free(cset); free(dsat); return 0; }
+    BBState s;
+    if (!bb_init(&s, n, adj, start, deg, 16)) { bb_free(&s); return 0; }
 
+    int max_c = 0;
     for (int iter = 0; iter < n; iter++) {
         /* Select vertex: max DSAT, tie-break max degree */
-        int u = -1;
-        for (int v = 0; v < n; v++) {
-            if (out_coloring[v] != -1) continue;
-            if (u == -1 ||
-                dsat[v] > dsat[u] ||
-               (dsat[v] == dsat[u] && deg[v] > deg[u]))
-                u = v;
-        }
+        int u = select_dsatur(&s);
 
         /* Assign smallest available color */
         int c = 0;
-        while (CS_HAS(cset[u], c)) c++;
-        out_coloring[u] = c;
-
-        /* Update uncolored neighbors */
-        for (int j = start[u]; j < start[u] + deg[u]; j++) {
-            int w = adj[j];
-            if (out_coloring[w] != -1) continue;
-            if (!CS_HAS(cset[w], c)) { CS_ADD(cset[w], c); dsat[w]++; }
+        while (c < s.ncolors && bb_ccnt(&s, u, c, s.ix)) c++;
+        if (c == s.ncolors && !grow_colors(&s, 2 * s.ncolors)) {
+            bb_copy_colors(&s, out_coloring);
+            bb_free(&s);
+            return first_fit_rest(n, adj, start, deg, out_coloring);
         }
+        colorier(&s, u, c);
+        if (c > max_c) max_c = c;
     }
 
-    int max_c = 0;
-    for (int v = 0; v < n; v++)
-        if (out_coloring[v] > max_c) max_c = out_coloring[v];
-
-    free(cset); free(dsat);
+    bb_copy_colors(&s, out_coloring);
+    bb_free(&s);
     return max_c + 1;
 }
+
+/* ── Proper colouring with every colour in [0, k) — O(n + m) ───────── */
+static int coloring_ok(int n, const int* adj, const int* start, const int* deg,
+                       const int* col, int k) {
+    for (int v = 0; v < n; v++) {
+        if (col[v] < 0 || col[v] >= k) return 0;
+        for (int j = start[v]; j < start[v] + deg[v]; j++)
+            if (col[adj[j]] == col[v]) return 0;
+    }
+    return 1;
+}
+
+/* ── Pre-solve stage ───────────────────────────────────────────────────
+ * Time-boxed bound tightening between the start-up heuristics and the
+ * B&B: a multi-start clique search for LB, then TabuCol seeded from the
+ * start-up colouring for UB. Its budget is presolve_share · temps_max.
+ * ─────────────────────────────────────────────────────────────────── */
+static double presolve_share = 0.05;
+
+EXPORT void bb_set_presolve_share(double share) {
+    presolve_share = share < 0.0 ? 0.0 : share > 1.0 ? 1.0 : share;
+}
+
+/* Exact clique search (clique.c) at the root: its own clique_share · temps_max */
+static double clique_share = 0.05;
+
+EXPORT void bb_set_clique_share(double share) {
+    clique_share = share < 0.0 ? 0.0 : share > 1.0 ? 1.0 : share;
+}
+
+static uint32_t xs32(uint32_t* x) {
+    *x ^= *x << 13; *x ^= *x >> 17; *x ^= *x << 5;
+    return *x;
+}
+
+static int cmp_int(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+/* ── Multi-start greedy clique ─────────────────────────────────────────
+ * One greedy clique per start vertex s (in degree order), grown from s
+ * through N(s) by decreasing degree. Stops once deg(s) + 1 cannot beat
+ * the best clique, or at the deadline. Returns max(lb, best size).
+ * ─────────────────────────────────────────────────────────────────── */
+static int multistart_clique(int n, const int* adj, const int* start, const int* deg,
+                             const uint64_t* amat, int awords, int lb, double deadline,
+                             const int* cancel) {
+    int  max_deg = max_key_of(deg, n);
+    int* order   = (int*)malloc(n * sizeof(int));
+    int* rank    = (int*)malloc(n * sizeof(int));
+    int* nb      = (int*)malloc((max_deg + 1) * sizeof(int));
+    int* clique  = (int*)malloc((max_deg + 1) * sizeof(int));
+    int* scratch = (int*)malloc(CSORT_SCRATCH(n, max_deg) * sizeof(int));
+    if (!order || !rank || !nb || !clique || !scratch) {
+        free(order); free(rank); free(nb); free(clique); free(scratch);
+        return lb;
+    }
+    for (int i = 0; i < n; i++) order[i] = i;
+    csort_desc(order, n, deg, max_deg, scratch);
+    free(scratch);
+    for (int i = 0; i < n; i++) rank[order[i]] = i;
+
+    int best = lb;
+    for (int i = 0; i < n && deg[order[i]] + 1 > best; i++) {
+        if ((i & 63) == 0 && (now_s() > deadline || bb_cancelled(cancel))) break;
+        int v = order[i], d = deg[v];
+        /* N(v) by rank, i.e. degree descending; sorting the ranks
+           themselves keeps this reentrant for concurrent solves */
+        for (int j = 0; j < d; j++) nb[j] = rank[adj[start[v] + j]];
+        qsort(nb, d, sizeof(int), cmp_int);
+        for (int j = 0; j < d; j++) nb[j] = order[nb[j]];
+
+        int sz = 0;
+        clique[sz++] = v;
+        for (int j = 0; j < d && sz + (d - j) > best; j++) {
+            int u = nb[j], ok = 1;
+            for (int t = 1; t < sz && ok; t++)
+                ok = amat ? adjmat_has(amat, awords, u, clique[t])
+                          : adj_has(adj, start[u], deg[u], clique[t]);
+            if (ok) clique[sz++] = u;
+        }
+        if (sz > best) best = sz;
+    }
+
+    free(order); free(rank); free(nb); free(clique);
+    return best;
+}
+
+/* ── TabuCol (Hertz & de Werra, 1987) ──────────────────────────────────
+ * col is a proper k-colouring. For target k-1, k-2, … (down to lb + 1)
+ * the top colour class is re-spread over the others by fewest
+ * conflicts, then tabu search minimises the conflict count over
+ * (vertex, colour) moves of conflicting vertices. gamma[v·kk + c] =
+ * neighbours of v coloured c; aspiration on the run's best count. A
+ * target is abandoned after `patience` non-improving moves. Returns the
+ * best k reached, its colouring left in col.
+ * ─────────────────────────────────────────────────────────────────── */
+#define TABU_MAX_CELLS  (32u << 20)
+
+static int tabucol(int n, const int* adj, const int* start, const int* deg,
+                   int* col, int k, int lb, double deadline, const int* cancel) {
+    if ((size_t)n * (size_t)k > TABU_MAX_CELLS) return k;
+
+    int*  cur   = (int*)malloc(n * sizeof(int));
+    int*  gamma = (int*)malloc((size_t)n * k * sizeof(int));
+    long* tabu  = (long*)malloc((size_t)n * k * sizeof(long));
+    int*  clist = (int*)malloc(n * sizeof(int));
+    int*  cpos  = (int*)malloc(n * sizeof(int));
+    if (!cur || !gamma || !tabu || !clist || !cpos) {
+        free(cur); free(gamma); free(tabu); free(clist); free(cpos);
+        return k;
+    }
+
+    uint32_t rng = 0x9E3779B9u;
+    long patience = 20000 + 10L * n;
+    long iter = 0;
+    int  done = 0;
+
+    while (k - 1 > lb && !done) {
+        int kk = k - 1;
+        memcpy(cur, col, n * sizeof(int));
+        memset(gamma, 0, (size_t)n * kk * sizeof(int));
+        memset(tabu, 0, (size_t)n * kk * sizeof(long));
+
+        /* gamma over the colours kept, then re-spread class kk */
+        for (int v = 0; v < n; v++) {
+            if (cur[v] == kk) continue;
+            for (int j = start[v]; j < start[v] + deg[v]; j++)
+                gamma[(size_t)adj[j] * kk + cur[v]]++;
+        }
+        for (int v = 0; v < n; v++) {
+            if (cur[v] != kk) continue;
+            const int* g = gamma + (size_t)v * kk;
+            int c = 0;
+            for (int t = 1; t < kk; t++) if (g[t] < g[c]) c = t;
+            cur[v] = c;
+            for (int j = start[v]; j < start[v] + deg[v]; j++)
+                gamma[(size_t)adj[j] * kk + c]++;
+        }
+
+        long f = 0;
+        int  nconf = 0;
+        for (int v = 0; v < n; v++) {
+            int g = gamma[(size_t)v * kk + cur[v]];
+            f += g;
+            cpos[v] = -1;
+            if (g > 0) { cpos[v] = nconf; clist[nconf++] = v; }
+        }
+        f /= 2;
+
+        long best_f = f, stall = 0;
+        while (f > 0) {
+            if ((++iter & 255) == 0 && (now_s() > deadline || bb_cancelled(cancel))) {
+                done = 1; break;
+            }
+            if (stall++ > patience) { done = 1; break; }
+
+            /* Best non-tabu move (or aspirating), ties at random */
+            int bv = -1, bc = -1, bd = INT_MAX, ties = 0;
+            for (int i = 0; i < nconf; i++) {
+                int v = clist[i], cv = cur[v];
+                const int*  g  = gamma + (size_t)v * kk;
+                const long* tb = tabu  + (size_t)v * kk;
+                for (int c = 0; c < kk; c++) {
+                    if (c == cv) continue;
+                    int d = g[c] - g[cv];
+                    if (d > bd) continue;
+                    if (tb[c] > iter && f + d >= best_f) continue;
+                    if (d < bd) { bd = d; ties = 0; }
+                    if (xs32(&rng) % (uint32_t)(++ties) == 0) { bv = v; bc = c; }
+                }
+            }
+            if (bv < 0) {                       /* everything tabu */
+                bv = clist[xs32(&rng) % (uint32_t)nconf];
+                bc = (int)(xs32(&rng) % (uint32_t)(kk - 1));
+                if (bc >= cur[bv]) bc++;
+                bd = gamma[(size_t)bv * kk + bc] - gamma[(size_t)bv * kk + cur[bv]];
+            }
+
+            /* Apply, keeping the conflicting-vertex list exact */
+            int old = cur[bv];
+            cur[bv] = bc;
+            for (int j = start[bv]; j < start[bv] + deg[bv]; j++) {
+                int w = adj[j];
+                gamma[(size_t)w * kk + old]--;
+                gamma[(size_t)w * kk + bc]++;
+                int conf = gamma[(size_t)w * kk + cur[w]] > 0;
+                if (conf && cpos[w] < 0) { cpos[w] = nconf; clist[nconf++] = w; }
+                else if (!conf && cpos[w] >= 0) {
+                    int last = clist[--nconf];
+                    clist[cpos[w]] = last; cpos[last] = cpos[w]; cpos[w] = -1;
+                }
+            }
+            {
+                int conf = gamma[(size_t)bv * kk + bc] > 0;
+                if (conf && cpos[bv] < 0) { cpos[bv] = nconf; clist[nconf++] = bv; }
+                else if (!conf && cpos[bv] >= 0) {
+                    int last = clist[--nconf];
+                    clist[cpos[bv]] = last; cpos[last] = cpos[bv]; cpos[bv] = -1;
+                }
+            }
+            tabu[(size_t)bv * kk + old] = iter + (long)(0.6 * nconf) + (long)(xs32(&rng) % 10);
+
+            f += bd;
+            if (f < best_f) { best_f = f; stall = 0; }
+        }
+
+        if (f == 0) { memcpy(col, cur, n * sizeof(int)); k = kk; }
+    }
+
+    free(cur); free(gamma); free(tabu); free(clist); free(cpos);
+    return k;
+}
+
+void initial_bounds(int n, const int* adj, const int* start, const int* deg,
+                    const uint64_t* amat, int awords, int temps_max,
+                    int known_LB, int warm_UB, const int* warm_coloring,
+                    const int* cancel, int* out_coloring, int* out_LB, int* out_UB) {
+    double t0 = now_s();
+    int ub = 0;
+    if (warm_coloring && warm_UB > 0 &&
+        coloring_ok(n, adj, start, deg, warm_coloring, warm_UB)) {
+        memcpy(out_coloring, warm_coloring, (size_t)n * sizeof(int));
+        for (int v = 0; v < n; v++) if (warm_coloring[v] + 1 > ub) ub = warm_coloring[v] + 1;
+    } else {
+        ub = dsatur(n, adj, start, deg, out_coloring);
+    }
+
+    int lb = known_LB;
+    if (lb < ub) {
+        int clique = amat ? greedy_clique_mat(n, deg, amat, awords)
+                          : greedy_clique(n, adj, start, deg);
+        if (clique > lb) lb = clique;
+    }
+
+    /* Pre-solve: half the budget for the clique search, the rest TabuCol.
+     * A cancel (bb_cancel() on the token) ends the current stage and skips
+     * the rest. */
+    double budget = presolve_share * (double)temps_max;
+    if (n > 0 && lb < ub && budget > 0.0)
+        lb = multistart_clique(n, adj, start, deg, amat, awords, lb, t0 + budget / 2, cancel);
+
+    /* Exact ω(G) from the heuristic clique up; ω ≤ χ ≤ ub caps it.
+     * A zero budget skips it: max_clique() reads 0 as no limit. */
+    double clique_budget = clique_share * (double)temps_max;
+    if (n > 0 && lb < ub && clique_budget > 0.0 && !bb_cancelled(cancel))
+        lb = max_clique(n, adj, start, deg, lb, ub, clique_budget, cancel, NULL);
+    if (n > 0 && lb < ub && budget > 0.0 && !bb_cancelled(cancel))
+        ub = tabucol(n, adj, start, deg, out_coloring, ub, lb, now_s() + budget / 2, cancel);
+
+    /* Fractional chromatic bound (frac.h) where ω leaves a gap, its LP
+     * seeded with the final colouring's classes */
+    double frac_budget = bb_frac_share() * (double)temps_max;
+    if (bb_frac_depth() >= 0 && lb < ub && !bb_cancelled(cancel))
+        lb = frac_root_lb(n, adj, start, deg, amat, awords, out_coloring, lb, ub, frac_budget,
+                          cancel);
+    *out_LB = lb;
+    *out_UB = ub;
+}
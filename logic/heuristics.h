@@ -2,12 +2,30 @@
 #ifndef HEURISTICS_H
 #define HEURISTICS_H
 
+/* ── Stable counting sort by key descending ────────────────────────────
+ * Reorders arr[0..len-1] by key[arr[i]] descending, ties keep their
+ * input order (same result as a stable insertion sort). Keys must lie
+ * in [0, max_key]. scratch must hold CSORT_SCRATCH(len, max_key) ints.
+ * O(len + max_key).
+ * ─────────────────────────────────────────────────────────────────── */
+#define CSORT_SCRATCH(len, max_key) ((size_t)(len) + (size_t)(max_key) + 2)
+
+EXPORT void csort_desc(int* arr, int len, const int* key, int max_key,
+                       int* scratch);
+
 /* ── Greedy max clique ──────────────────────────────────────────────────
  * Order vertices by degree descending, greedily extend clique.
  * Returns ω(G) approximation (valid lower bound for χ(G)).
  * ─────────────────────────────────────────────────────────────────── */
 EXPORT int greedy_clique(int n, const int* adj, const int* start, const int* deg);
 
+/* ── Greedy max clique on the adjacency bit-matrix ─────────────────────
+ * Same greedy order as greedy_clique(); the candidate set is kept as a
+ * bitset and narrowed with one word-wise AND per accepted vertex.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int greedy_clique_mat(int n, const int* deg,
+                             const uint64_t* amat, int awords);
+
 /* ── DSATUR heuristic colouring ────────────────────────────────────────
  * Returns χ_DSATUR (valid upper bound for χ(G)).
  * Writes the colouring into out_coloring[0..n-1].
@@ -15,4 +33,27 @@ EXPORT int greedy_clique(int n, const int* adj, const int* start, const int* deg
 EXPORT int dsatur(int n, const int* adj, const int* start, const int* deg,
                   int* out_coloring);
 
+/* ── Share of temps_max given to the pre-solve stage (default 0.05) ── */
+EXPORT void bb_set_presolve_share(double share);
+
+/* ── Share of temps_max for the exact root clique (default 0.05) ───── */
+EXPORT void bb_set_clique_share(double share);
+
+/* ── Start-up bounds for the B&B engines ───────────────────────────────
+ * LB = max(known_LB, greedy clique), UB from DSATUR into out_coloring.
+ * A warm start (warm_UB > 0 and warm_coloring a proper colouring with
+ * colours < warm_UB) replaces DSATUR; if known_LB already meets it the
+ * clique search is skipped too. While a gap remains, a pre-solve stage
+ * (multi-start clique, then TabuCol) spends up to
+ * presolve_share · temps_max seconds narrowing it, and between the two
+ * the exact max_clique() gets clique_share · temps_max to raise LB to
+ * ω(G). Last, when bb_set_frac_depth() enables it, the fractional
+ * bound (frac.h) gets its own share. amat and cancel (the solve's
+ * token, which ends the stages early) may be NULL.
+ * ─────────────────────────────────────────────────────────────────── */
+void initial_bounds(int n, const int* adj, const int* start, const int* deg,
+                    const uint64_t* amat, int awords, int temps_max,
+                    int known_LB, int warm_UB, const int* warm_coloring,
+                    const int* cancel, int* out_coloring, int* out_LB, int* out_UB);
+
 #endif
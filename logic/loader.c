@@ -0,0 +1,179 @@
+/*
+ * loader.c
+ * ────────
+ * Native DIMACS .col reader: parses the raw file bytes (an upload or a
+ * memory-mapped file) straight into sorted, deduplicated CSR held in
+ * caller-owned buffers, without building any per-edge Python objects.
+ *
+ *   dimacs_scan : pass 1 — vertex count and an edge-line upper bound
+ *   dimacs_csr  : passes 2-3 — degrees, fill, per-row sort + dedupe
+ *   csr_check   : validates CSR arrays read back from a binary .csr file
+ *   bb_graph_fingerprint : content hash of a CSR graph (cache key)
+ *
+ * Accepts exactly what graph.parse_dimacs() accepts: blank lines and
+ * lines starting with 'c' are skipped, "p <fmt> <n> …" sets n (the last
+ * one wins), "e <u> <v>" adds edge {u-1, v-1}; lines with fewer than
+ * three fields are ignored. Endpoints outside [1, n] are dropped.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+
+/* ── Line tokenizer over [p, end) ──────────────────────────────────── */
+static int is_blank(char ch) { return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f'; }
+
+static const char* skip_blank(const char* p, const char* end) {
+    while (p < end && is_blank(*p)) p++;
+    return p;
+}
+
+static const char* skip_token(const char* p, const char* end) {
+    while (p < end && *p != '\n' && !is_blank(*p)) p++;
+    return p;
+}
+
+static const char* next_line(const char* p, const char* end) {
+    const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+    return nl ? nl + 1 : end;
+}
+
+/* Whole token [p, q) as a decimal integer (optional sign); 0 = not one */
+static int token_long(const char* p, const char* q, long long* out) {
+    int neg = 0;
+    if (p < q && (*p == '+' || *p == '-')) neg = (*p++ == '-');
+    if (p == q) return 0;
+    long long x = 0;
+    for (; p < q; p++) {
+        if (*p < '0' || *p > '9') return 0;
+        if (x < (1LL << 40)) x = x * 10 + (*p - '0');   /* saturate */
+    }
+    *out = neg ? -x : x;
+    return 1;
+}
+
+/* ── One parsed line ────────────────────────────────────────────────────
+ * Returns 'p' / 'e' with a, b = 3rd / 2nd-and-3rd fields, 0 for a line to
+ * skip, -1 for a malformed number. *pp advances to the next line.
+ * ─────────────────────────────────────────────────────────────────── */
+static int parse_line(const char** pp, const char* end, long long* a, long long* b) {
+    const char* p = skip_blank(*pp, end);
+    const char* eol = next_line(p, end);
+    *pp = eol;
+    if (p == eol || *p == '\n' || *p == 'c') return 0;
+    char kind = *p;
+    if (kind != 'p' && kind != 'e') return 0;
+
+    const char* f[3][2];
+    int nf = 0;
+    while (nf < 3) {
+        p = skip_blank(p, end);
+        if (p >= end || *p == '\n') break;
+        f[nf][0] = p; p = skip_token(p, end); f[nf][1] = p;
+        nf++;
+    }
+    if (nf < 3) return 0;
+
+    if (kind == 'p')
+        return token_long(f[2][0], f[2][1], a) ? 'p' : -1;
+    return (token_long(f[1][0], f[1][1], a) && token_long(f[2][0], f[2][1], b)) ? 'e' : -1;
+}
+
+/* ── Pass 1 ────────────────────────────────────────────────────────────
+ * *out_n = vertex count, *out_edges = number of e-lines (so the CSR
+ * needs at most 2 · *out_edges adjacency slots). Returns 1, 0 when no
+ * "p" line gives n > 0, or -(line number) of the first malformed line.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int dimacs_scan(const char* buf, long len, int* out_n, long* out_edges) {
+    const char* p = buf;
+    const char* end = buf + len;
+    long long n = 0, a, b;
+    long edges = 0, line = 0;
+    while (p < end) {
+        line++;
+        int kind = parse_line(&p, end, &a, &b);
+        if (kind < 0) return (int)-(line < INT_MAX ? line : INT_MAX);
+        if (kind == 'p') n = a;
+        else if (kind == 'e') edges++;
+    }
+    if (n <= 0 || n > INT_MAX) return 0;
+    *out_n = (int)n;
+    *out_edges = edges;
+    return 1;
+}
+
+static int cmp_int(const void* x, const void* y) {
+    int a = *(const int*)x, b = *(const int*)y;
+    return (a > b) - (a < b);
+}
+
+/* ── Passes 2-3: CSR with sorted, duplicate-free rows ──────────────────
+ * n / edges from dimacs_scan(); adj must hold 2 · edges ints, start and
+ * deg n ints. Returns the number of adjacency entries used (Σ deg).
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT long dimacs_csr(const char* buf, long len, int n, long edges,
+                       int* adj, int* start, int* deg) {
+    const char* end = buf + len;
+    long long a, b;
+    (void)edges;
+
+    /* Degrees with multiplicity */
+    memset(deg, 0, (size_t)n * sizeof(int));
+    for (const char* p = buf; p < end; ) {
+        if (parse_line(&p, end, &a, &b) != 'e') continue;
+        if (a < 1 || a > n || b < 1 || b > n) continue;
+        deg[a - 1]++; deg[b - 1]++;
+    }
+
+    /* start[v] doubles as the fill cursor, ending at the row's end */
+    long pos = 0;
+    for (int v = 0; v < n; v++) { start[v] = (int)pos; pos += deg[v]; }
+    for (const char* p = buf; p < end; ) {
+        if (parse_line(&p, end, &a, &b) != 'e') continue;
+        if (a < 1 || a > n || b < 1 || b > n) continue;
+        int u = (int)a - 1, v = (int)b - 1;
+        adj[start[u]++] = v;
+        adj[start[v]++] = u;
+    }
+
+    /* Sort + dedupe each row, compacting leftwards in place */
+    long w = 0;
+    for (int v = 0; v < n; v++) {
+        int* row = adj + (start[v] - deg[v]);
+        int  d   = deg[v];
+        if (d > 1) qsort(row, (size_t)d, sizeof(int), cmp_int);
+        start[v] = (int)w;
+        int kept = 0;
+        for (int i = 0; i < d; i++) {
+            if (i > 0 && row[i] == row[i - 1]) continue;
+            adj[w + kept++] = row[i];
+        }
+        deg[v] = kept;
+        w += kept;
+    }
+    return w;
+}
+
+/* ── CSR sanity check for buffers loaded from disk ─────────────────────
+ * Rows tile adj[0..entries) in order, neighbours lie in [0, n) and are
+ * strictly increasing. Returns 1 if valid.
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int csr_check(int n, long entries, const int* adj,
+                     const int* start, const int* deg) {
+    long pos = 0;
+    for (int v = 0; v < n; v++) {
+        if (start[v] != pos || deg[v] < 0 || pos + deg[v] > entries) return 0;
+        for (int j = start[v]; j < start[v] + deg[v]; j++) {
+            if (adj[j] < 0 || adj[j] >= n) return 0;
+            if (j > start[v] && adj[j] <= adj[j - 1]) return 0;
+        }
+        pos += deg[v];
+    }
+    return pos == entries;
+}
+
+/* ── graph_fingerprint() for callers outside the library ───────────── */
+EXPORT uint64_t bb_graph_fingerprint(int n, const int* adj,
+                                     const int* start, const int* deg) {
+    return graph_fingerprint(n, adj, start, deg);
+}
@@ -0,0 +1,325 @@
+/*
+ * parallel.c
+ * ──────────
+ * Work-stealing driver for the DSATUR B&B engines (see parallel.h).
+ *
+ * Termination: `pending` counts tasks pushed but not yet finished
+ * (the root counts as one). A worker with an empty deque marks itself
+ * idle and steals round-robin until it gets a task, `pending` drops to
+ * zero, the shared UB meets the LB, or the time limit fires.
+ */
+
+#include "coloring.h"
+#include "parallel.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Cancellation token (see coloring.h) ───────────────────────────── */
+EXPORT void bb_cancel(int* cancel) {
+    if (cancel) __atomic_store_n(cancel, 1, __ATOMIC_RELAXED);
+}
+
+/* ── Deque primitives (callers hold dq->lock) ──────────────────────── */
+static int dq_push(ParDeque* dq, ParTask* t) {
+    if (dq->tail == dq->cap) {
+        if (dq->head > 0) {
+            memmove(dq->items, dq->items + dq->head,
+                    (dq->tail - dq->head) * sizeof(ParTask*));
+            dq->tail -= dq->head; dq->head = 0;
+        } else {
+            int cap = dq->cap ? 2 * dq->cap : 16;
+            ParTask** it = (ParTask**)realloc(dq->items, cap * sizeof(ParTask*));
+            if (!it) return 0;
+            dq->items = it; dq->cap = cap;
+        }
+    }
+    dq->items[dq->tail++] = t;
+    return 1;
+}
+
+static ParTask* dq_pop_back(ParDeque* dq) {
+    if (dq->head == dq->tail) return NULL;
+    ParTask* t = dq->items[--dq->tail];
+    if (dq->head == dq->tail) dq->head = dq->tail = 0;
+    return t;
+}
+
+static ParTask* dq_pop_front(ParDeque* dq) {
+    if (dq->head == dq->tail) return NULL;
+    ParTask* t = dq->items[dq->head++];
+    if (dq->head == dq->tail) dq->head = dq->tail = 0;
+    return t;
+}
+
+/* ── Hand-off of branch (v, c) at the current node ──────────────────
+ * Only while the local deque is shorter than the number of idle
+ * workers, so busy phases pay nothing beyond par_wants_work().
+ * ─────────────────────────────────────────────────────────────────── */
+int par_offload(BBState* s, int v, int c, int k) {
+    ParShared* sh = s->shared;
+    ParDeque*  dq = &sh->deques[s->worker_id];
+
+    bb_mutex_lock(&dq->lock);
+    int queued = dq->tail - dq->head;
+    bb_mutex_unlock(&dq->lock);
+    if (queued >= __atomic_load_n(&sh->idle, __ATOMIC_RELAXED)) return 0;
+
+    int len = 1;
+    for (int u = 0; u < s->n; u++) if (s->vert[u].color != -1) len++;
+
+    ParTask* t = (ParTask*)malloc(sizeof(ParTask) + 2 * (size_t)len * sizeof(int));
+    if (!t) return 0;
+    t->k = k; t->len = len;
+    int i = 0;
+    for (int u = 0; u < s->n; u++)
+        if (s->vert[u].color != -1) { t->vc[i++] = u; t->vc[i++] = s->vert[u].color; }
+    t->vc[i++] = v; t->vc[i] = c;
+
+    __atomic_add_fetch(&sh->pending, 1, __ATOMIC_ACQ_REL);
+    bb_mutex_lock(&dq->lock);
+    int ok = dq_push(dq, t);
+    bb_mutex_unlock(&dq->lock);
+    if (!ok) {
+        __atomic_sub_fetch(&sh->pending, 1, __ATOMIC_ACQ_REL);
+        free(t);
+    }
+    return ok;
+}
+
+/* ── New incumbent: lower the shared UB, copy the colouring ────────── */
+void par_publish(BBState* s, int k) {
+    ParShared* sh = s->shared;
+    bb_mutex_lock(&sh->best_lock);
+    if (k < __atomic_load_n(&sh->UB, __ATOMIC_ACQUIRE)) {
+        bb_copy_colors(s, sh->best_color);
+        __atomic_store_n(&sh->UB, k, __ATOMIC_RELEASE);
+    }
+    bb_mutex_unlock(&sh->best_lock);
+}
+
+/* ── Progress: every PROGRESS_EVERY local nodes, record from worker 0 ─ */
+void par_progress(BBState* s, int depth) {
+    if (s->nodes_visited != 1 && s->nodes_visited % PROGRESS_EVERY != 0) return;
+    ParShared* sh = s->shared;
+    __atomic_store_n(&sh->nodes[s->worker_id], s->nodes_visited, __ATOMIC_RELAXED);
+    __atomic_store_n(&sh->cuts[s->worker_id],  s->branches_cut,  __ATOMIC_RELAXED);
+    if (!s->progress) return;
+
+    long nodes = 0, cuts = 0;
+    for (int i = 0; i < sh->n_workers; i++) {
+        nodes += __atomic_load_n(&sh->nodes[i], __ATOMIC_RELAXED);
+        cuts  += __atomic_load_n(&sh->cuts[i],  __ATOMIC_RELAXED);
+    }
+    progress_push(s->progress, nodes, cuts, s->UB, s->LB, depth, now_s() - s->time_start);
+}
+
+/* ── Next task for worker id: own deque first, then steal ─────────── */
+static int search_over(ParShared* sh) {
+    return __atomic_load_n(&sh->timeout, __ATOMIC_RELAXED)
+        || __atomic_load_n(&sh->stop, __ATOMIC_RELAXED)
+        || __atomic_load_n(&sh->UB, __ATOMIC_ACQUIRE) <= sh->LB;
+}
+
+static ParTask* next_task(ParShared* sh, int id) {
+    ParDeque* own = &sh->deques[id];
+    bb_mutex_lock(&own->lock);
+    ParTask* t = dq_pop_back(own);
+    bb_mutex_unlock(&own->lock);
+    if (t) return t;
+
+    __atomic_add_fetch(&sh->idle, 1, __ATOMIC_ACQ_REL);
+    for (;;) {
+        for (int i = 1; i < sh->n_workers && !t; i++) {
+            ParDeque* dq = &sh->deques[(id + i) % sh->n_workers];
+            bb_mutex_lock(&dq->lock);
+            t = dq_pop_front(dq);
+            bb_mutex_unlock(&dq->lock);
+        }
+        if (t || __atomic_load_n(&sh->pending, __ATOMIC_ACQUIRE) == 0
+              || search_over(sh)) break;
+        bb_yield();
+    }
+    __atomic_sub_fetch(&sh->idle, 1, __ATOMIC_ACQ_REL);
+    return t;
+}
+
+/* ── Worker: replay, explore, undo, repeat ─────────────────────────── */
+typedef struct {
+    BBState*  s;
+    ExploreFn explore;
+} WorkerArg;
+
+static BB_THREAD_RET worker_main(void* arg) {
+    WorkerArg* wa = (WorkerArg*)arg;
+    BBState*   s  = wa->s;
+    ParShared* sh = s->shared;
+
+    ParTask* t;
+    while ((t = next_task(sh, s->worker_id)) != NULL) {
+        if (!search_over(sh)) {
+            for (int i = 0; i < t->len; i++) colorier(s, t->vc[2*i], t->vc[2*i+1]);
+            par_sync(s);
+            wa->explore(s, t->len, t->k);
+            par_sync(s);
+            for (int i = t->len - 1; i >= 0; i--) decolorier(s, t->vc[2*i], t->vc[2*i+1]);
+        }
+        free(t);
+        __atomic_sub_fetch(&sh->pending, 1, __ATOMIC_ACQ_REL);
+    }
+    __atomic_store_n(&sh->nodes[s->worker_id], s->nodes_visited, __ATOMIC_RELAXED);
+    __atomic_store_n(&sh->cuts[s->worker_id],  s->branches_cut,  __ATOMIC_RELAXED);
+    BB_THREAD_RETURN;
+}
+
+/* ── Driver ────────────────────────────────────────────────────────── */
+void par_explore(BBState* s, int n_threads, ExploreFn explore, WorkerInitFn init) {
+    if (n_threads <= 1) { explore(s, 0, 0); return; }
+
+    ParShared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.n_workers  = n_threads;
+    sh.UB         = s->UB;
+    sh.LB         = s->LB;
+    sh.best_color = s->best_color;
+    sh.deques  = (ParDeque*)calloc(n_threads, sizeof(ParDeque));
+    sh.nodes   = (long*)calloc(n_threads, sizeof(long));
+    sh.cuts    = (long*)calloc(n_threads, sizeof(long));
+    BBState*     ws   = (BBState*)calloc(n_threads, sizeof(BBState));
+    WorkerArg*   args = (WorkerArg*)calloc(n_threads, sizeof(WorkerArg));
+    bb_thread_t* th   = (bb_thread_t*)calloc(n_threads, sizeof(bb_thread_t));
+    ParTask*     root = (ParTask*)malloc(sizeof(ParTask));
+    if (!sh.deques || !sh.nodes || !sh.cuts || !ws || !args || !th || !root) {
+        free(sh.deques); free(sh.nodes); free(sh.cuts);
+        free(ws); free(args); free(th); free(root);
+        explore(s, 0, 0);
+        return;
+    }
+    for (int i = 0; i < n_threads; i++) bb_mutex_init(&sh.deques[i].lock);
+    bb_mutex_init(&sh.best_lock);
+
+    /* The root task is queued before any thief can look for it */
+    root->k = 0; root->len = 0;
+    sh.pending = 1;
+    dq_push(&sh.deques[0], root);
+
+    /* Worker 0 is s itself; the others get fresh copies of the root */
+    s->shared = &sh; s->worker_id = 0;
+    int* started = (int*)calloc(n_threads, sizeof(int));
+    for (int i = 1; i < n_threads && started; i++) {
+        BBState* w = &ws[i];
+        if (!bb_init(w, s->n, s->adj, s->start, s->deg, s->ncolors) ||
+            (init && !init(w, s))) {
+            w->amat = NULL; w->adj16 = NULL; bb_free(w);
+            continue;
+        }
+        w->amat = s->amat; w->awords = s->awords;   /* borrowed, read-only */
+        bb_use_adj16(w, s->adj16);
+        w->UB = s->UB; w->LB = s->LB;
+        w->best_color = s->best_color;
+        w->time_start = s->time_start; w->temps_max = s->temps_max;
+        w->cancel = s->cancel; w->ext_LB = s->ext_LB;
+        w->shared = &sh; w->worker_id = i;
+        args[i].s = w; args[i].explore = explore;
+        started[i] = bb_thread_start(&th[i], worker_main, &args[i]);
+        if (!started[i]) { w->amat = NULL; w->adj16 = NULL; bb_free(w); }
+    }
+
+    args[0].s = s; args[0].explore = explore;
+    worker_main(&args[0]);
+
+    for (int i = 1; i < n_threads; i++) {
+        if (!started || !started[i]) continue;
+        bb_thread_join(th[i]);
+        s->nodes_visited += ws[i].nodes_visited;
+        s->branches_cut  += ws[i].branches_cut;
+        BB_STAT(bb_stats_add(&s->stats, &ws[i].stats));
+        ws[i].amat = NULL; ws[i].adj16 = NULL; bb_free(&ws[i]);
+    }
+
+    /* Tasks left behind by an early stop */
+    for (int i = 0; i < n_threads; i++) {
+        ParTask* t;
+        while ((t = dq_pop_back(&sh.deques[i])) != NULL) free(t);
+        free(sh.deques[i].items);
+        bb_mutex_destroy(&sh.deques[i].lock);
+    }
+    bb_mutex_destroy(&sh.best_lock);
+
+    s->UB      = sh.UB;
+    s->timeout = sh.timeout;
+    s->shared  = NULL;
+
+    free(started); free(sh.deques); free(sh.nodes); free(sh.cuts);
+    free(ws); free(args); free(th);
+}
+
+/* ── Portfolio ─────────────────────────────────────────────────────── */
+typedef struct {
+    BBState*  s;
+    ExploreFn explore;
+} MemberArg;
+
+static BB_THREAD_RET member_main(void* arg) {
+    MemberArg* ma = (MemberArg*)arg;
+    BBState*   s  = ma->s;
+    ParShared* sh = s->shared;
+
+    ma->explore(s, 0, 0);
+    par_sync(s);
+    if (!s->stop) {
+        int none = -1;
+        __atomic_compare_exchange_n(&sh->winner, &none, s->worker_id, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&sh->stop, 1, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&sh->nodes[s->worker_id], s->nodes_visited, __ATOMIC_RELAXED);
+    __atomic_store_n(&sh->cuts[s->worker_id],  s->branches_cut,  __ATOMIC_RELAXED);
+    BB_THREAD_RETURN;
+}
+
+int par_portfolio(BBState** ws, const ExploreFn* explore, int n) {
+    BBState* s = ws[0];
+
+    ParShared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.n_workers  = n;
+    sh.UB         = s->UB;
+    sh.LB         = s->LB;
+    sh.best_color = s->best_color;
+    sh.winner     = -1;
+    sh.nodes = (long*)calloc(n, sizeof(long));
+    sh.cuts  = (long*)calloc(n, sizeof(long));
+    MemberArg*   args    = (MemberArg*)calloc(n, sizeof(MemberArg));
+    bb_thread_t* th      = (bb_thread_t*)calloc(n, sizeof(bb_thread_t));
+    int*         started = (int*)calloc(n, sizeof(int));
+    if (!sh.nodes || !sh.cuts || !args || !th || !started) {
+        free(sh.nodes); free(sh.cuts); free(args); free(th); free(started);
+        explore[0](s, 0, 0);
+        return s->stop ? -1 : 0;
+    }
+    bb_mutex_init(&sh.best_lock);
+
+    for (int i = 0; i < n; i++) {
+        ws[i]->shared = &sh; ws[i]->worker_id = i;
+        args[i].s = ws[i]; args[i].explore = explore[i];
+    }
+    for (int i = 1; i < n; i++)
+        started[i] = bb_thread_start(&th[i], member_main, &args[i]);
+    member_main(&args[0]);
+
+    for (int i = 1; i < n; i++) {
+        if (!started[i]) continue;
+        bb_thread_join(th[i]);
+        s->nodes_visited += ws[i]->nodes_visited;
+        s->branches_cut  += ws[i]->branches_cut;
+        BB_STAT(bb_stats_add(&s->stats, &ws[i]->stats));
+    }
+    bb_mutex_destroy(&sh.best_lock);
+    for (int i = 0; i < n; i++) ws[i]->shared = NULL;
+
+    s->UB      = sh.UB;
+    s->timeout = sh.timeout && sh.winner < 0;
+
+    free(sh.nodes); free(sh.cuts); free(args); free(th); free(started);
+    return sh.winner;
+}
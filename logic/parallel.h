@@ -0,0 +1,168 @@
+#pragma once
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/*
+ * parallel.h
+ * ──────────
+ * Work-stealing driver shared by the Sewell and Furini engines.
+ *
+ * Every worker owns a full BBState copy and runs the engine's own
+ * explore(). A subproblem is the partial colouring leading to a node:
+ * the worker that owns it replays it with colorier(), explores the
+ * subtree, then undoes it. Workers hand off untried sibling branches
+ * only while someone is idle, so the tree is split on demand rather
+ * than up front. The incumbent UB is one atomic int read at every node.
+ */
+
+#include "coloring.h"
+
+#ifdef _WIN32
+  typedef HANDLE           bb_thread_t;
+  typedef CRITICAL_SECTION bb_mutex_t;
+  #define BB_THREAD_RET    DWORD WINAPI
+  #define BB_THREAD_RETURN return 0
+  static inline int  bb_thread_start(bb_thread_t* t, LPTHREAD_START_ROUTINE fn, void* arg) {
+      *t = CreateThread(NULL, 0, fn, arg, 0, NULL);
+      return *t != NULL;
+  }
+  static inline void bb_thread_join(bb_thread_t t) { WaitForSingleObject(t, INFINITE); CloseHandle(t); }
+  static inline void bb_mutex_init(bb_mutex_t* m)    { InitializeCriticalSection(m); }
+  static inline void bb_mutex_destroy(bb_mutex_t* m) { DeleteCriticalSection(m); }
+  static inline void bb_mutex_lock(bb_mutex_t* m)    { EnterCriticalSection(m); }
+  static inline void bb_mutex_unlock(bb_mutex_t* m)  { LeaveCriticalSection(m); }
+  static inline void bb_yield(void) { SwitchToThread(); }
+#else
+  #include <pthread.h>
+  #include <sched.h>
+  typedef pthread_t        bb_thread_t;
+  typedef pthread_mutex_t  bb_mutex_t;
+  #define BB_THREAD_RET    void*
+  #define BB_THREAD_RETURN return NULL
+  static inline int  bb_thread_start(bb_thread_t* t, void* (*fn)(void*), void* arg) {
+      return pthread_create(t, NULL, fn, arg) == 0;
+  }
+  static inline void bb_thread_join(bb_thread_t t) { pthread_join(t, NULL); }
+  static inline void bb_mutex_init(bb_mutex_t* m)    { pthread_mutex_init(m, NULL); }
+  static inline void bb_mutex_destroy(bb_mutex_t* m) { pthread_mutex_destroy(m); }
+  static inline void bb_mutex_lock(bb_mutex_t* m)    { pthread_mutex_lock(m); }
+  static inline void bb_mutex_unlock(bb_mutex_t* m)  { pthread_mutex_unlock(m); }
+  static inline void bb_yield(void) { sched_yield(); }
+#endif
+
+/* ── Subproblem: the (vertex, colour) pairs coloured at its root ────── */
+typedef struct {
+    int k;          /* colours in use after replay                     */
+    int len;        /* number of pairs                                 */
+    int vc[];       /* vc[2i] = vertex, vc[2i+1] = colour              */
+} ParTask;
+
+/* ── Per-worker deque: owner pushes/pops the back, thieves take the
+ *    front (oldest = shallowest = largest subtree) ─────────────────── */
+typedef struct {
+    bb_mutex_t lock;
+    ParTask**  items;
+    int        head, tail, cap;
+} ParDeque;
+
+typedef struct ParShared {
+    int        n_workers;
+    ParDeque*  deques;
+
+    int        UB;          /* atomic: incumbent colour count          */
+    int        LB;          /* global lower bound (read-only)          */
+    int        timeout;     /* atomic: any worker hit temps_max        */
+    int        stop;        /* atomic: search over, all workers unwind */
+    int        idle;        /* atomic: workers currently out of work   */
+    long       pending;     /* atomic: tasks queued or running         */
+
+    bb_mutex_t best_lock;   /* guards best_color                       */
+    int*       best_color;
+
+    long*      nodes;       /* per-worker counters, published every    */
+    long*      cuts;        /*   PROGRESS_EVERY nodes, for progress    */
+
+    int        winner;      /* atomic: portfolio member that finished  */
+} ParShared;
+
+typedef void (*ExploreFn)(BBState* s, int nb_col, int k);
+
+/* ── One explore() per ColorSet width and index layout ─────────────────
+ * For a CS_INLINE name##_w(BBState*, int nb_col, int k, int W, int L),
+ * expands to instances with W = 1, 2, 4, 8 under BB_IX16 and BB_IX32,
+ * one with W = s->cwords and L = s->ix for everything else, and to
+ * name##_for(s) picking the one for the state s.
+ * ─────────────────────────────────────────────────────────────────── */
+#define BB_EXPLORE_AT(name, tag, W, L)                                         \
+    static void name##_##tag(BBState* s, int nb_col, int k) { name##_w(s, nb_col, k, W, L); }
+
+#define BB_EXPLORE_BY_WIDTH(name)                                              \
+    BB_EXPLORE_AT(name, 1_16, 1, BB_IX16)  BB_EXPLORE_AT(name, 1_32, 1, BB_IX32) \
+    BB_EXPLORE_AT(name, 2_16, 2, BB_IX16)  BB_EXPLORE_AT(name, 2_32, 2, BB_IX32) \
+    BB_EXPLORE_AT(name, 4_16, 4, BB_IX16)  BB_EXPLORE_AT(name, 4_32, 4, BB_IX32) \
+    BB_EXPLORE_AT(name, 8_16, 8, BB_IX16)  BB_EXPLORE_AT(name, 8_32, 8, BB_IX32) \
+    BB_EXPLORE_AT(name, n, s->cwords, s->ix)                                   \
+    static ExploreFn name##_for(const BBState* s) {                            \
+        int narrow = s->ix == BB_IX16;                                         \
+        if (s->ix == BB_IX32W) return name##_n;                                \
+        switch (s->cwords) {                                                   \
+        case 1:  return narrow ? name##_1_16 : name##_1_32;                    \
+        case 2:  return narrow ? name##_2_16 : name##_2_32;                    \
+        case 4:  return narrow ? name##_4_16 : name##_4_32;                    \
+        case 8:  return narrow ? name##_8_16 : name##_8_32;                    \
+        default: return name##_n;                                              \
+        }                                                                      \
+    }
+
+/* Engine-specific per-worker setup (e.g. Furini's arena). 0 = failure */
+typedef int (*WorkerInitFn)(BBState* w, const BBState* root);
+
+/* ── Run explore() from the root of s on n_threads workers ─────────────
+ * s must be initialised as for a sequential run (all vertices
+ * uncoloured, UB/LB/best_color/time fields set). On return s->UB,
+ * s->nodes_visited, s->branches_cut and s->timeout hold the totals
+ * over all workers and s->best_color the best colouring found.
+ * n_threads ≤ 1 is exactly explore(s, 0, 0).
+ * ─────────────────────────────────────────────────────────────────── */
+void par_explore(BBState* s, int n_threads, ExploreFn explore, WorkerInitFn init);
+
+/* ── Independent root searches sharing one incumbent (portfolio) ─────
+ * ws[i] runs explore[i](ws[i], 0, 0) on its own thread, ws[0] on the
+ * caller's. All states start from the same root, UB, LB, best_color
+ * and clock. The first search to finish without being stopped has
+ * proved its UB optimal and stops the others. Returns its index, or -1
+ * when the time limit fired first. Totals are accumulated into ws[0]
+ * as for par_explore().
+ * ─────────────────────────────────────────────────────────────────── */
+int  par_portfolio(BBState** ws, const ExploreFn* explore, int n);
+
+/* ── Engine kernels, for drivers that mix engines ──────────────────── */
+void sewell_explore(BBState* s, int nb_col, int k);
+void furini_explore(BBState* s, int nb_col, int k);
+int  furini_worker_init(BBState* w, const BBState* root);
+
+/* Give branch (v, c) of the current node to the worker's deque */
+int  par_offload(BBState* s, int v, int c, int k);
+
+/* Record a leaf colouring with k < every incumbent seen so far */
+void par_publish(BBState* s, int k);
+
+/* Per-node: publish counters, progress record from worker 0 */
+void par_progress(BBState* s, int depth);
+
+/* ── Per-node sync: pull the shared UB, propagate timeouts / stops ─── */
+static inline void par_sync(BBState* s) {
+    ParShared* sh = s->shared;
+    int ub = __atomic_load_n(&sh->UB, __ATOMIC_ACQUIRE);
+    if (ub < s->UB) s->UB = ub;
+    if (s->timeout) __atomic_store_n(&sh->timeout, 1, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&sh->timeout, __ATOMIC_RELAXED) ||
+        __atomic_load_n(&sh->stop, __ATOMIC_RELAXED)) s->stop = 1;
+}
+
+/* Cheap test before par_offload(): someone is waiting for work */
+static inline int par_wants_work(const BBState* s) {
+    return __atomic_load_n(&s->shared->idle, __ATOMIC_RELAXED) > 0;
+}
+
+#endif
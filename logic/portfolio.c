@@ -0,0 +1,140 @@
+/*
+ * portfolio.c
+ * ───────────
+ * Cooperative portfolio: Sewell and Furini (and reseeded variants of
+ * both) search the same root on separate threads from one shared
+ * greedy_clique + DSATUR startup. They share the incumbent colouring
+ * (atomic UB) and the global LB; the first member to finish its tree
+ * has proved optimality and stops the rest.
+ *
+ * Member i runs engine i % 2 (0 = Sewell, 1 = Furini) with DSATUR ties
+ * permuted by seed i / 2 (seed 0 = the canonical index order), so two
+ * threads give exactly today's Sewell-vs-Furini race, but cooperative.
+ */
+
+#include "coloring.h"
+#include "heuristics.h"
+#include "parallel.h"
+#include "reduce.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PORTFOLIO_MAX 64
+
+/* ── Portfolio run on one graph (the BBSolveFn of reduce.h) ────────────
+ * n_threads members, clamped to [2, PORTFOLIO_MAX]; x->out_winner gets
+ * the index of the member that proved optimality, -1 if none did.
+ * ─────────────────────────────────────────────────────────────────── */
+static int solve(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x
+) {
+    double t0 = now_s();
+    int members = n_threads < 2 ? 2 : n_threads > PORTFOLIO_MAX ? PORTFOLIO_MAX : n_threads;
+
+    /* Adjacency backend: bit-matrix for dense graphs, CSR otherwise */
+    int awords = 0;
+    uint64_t* amat = adjmat_wanted(n, deg)
+                   ? adjmat_build(n, adj, start, deg, &awords) : NULL;
+    uint16_t* adj16 = adj16_build(n, adj, start, deg);
+
+    /* Initial bounds, computed once for every member */
+    int LB, ub_init;
+    initial_bounds(n, adj, start, deg, amat, awords, temps_max,
+                   x->known_LB, x->warm_UB, x->warm_coloring, x->cancel,
+                   out_coloring, &LB, &ub_init);
+
+    BBState   st[PORTFOLIO_MAX];
+    BBState*  ws[PORTFOLIO_MAX];
+    ExploreFn ex[PORTFOLIO_MAX];
+    int       member[PORTFOLIO_MAX];   /* ws index → member index */
+    int used = 0, ok = 1;
+
+    for (int i = 0; i < members && ok; i++) {
+        BBState* s = &st[used];
+        int good = bb_init(s, n, adj, start, deg, ub_init);
+        s->amat = amat; s->awords = awords;   /* member 0 owns them */
+        bb_use_adj16(s, adj16);
+        s->best_color = out_coloring;
+        s->LB = LB; s->UB = ub_init;
+        s->temps_max = temps_max;
+        s->time_start = t0;
+        s->cancel = x->cancel;
+        s->ext_LB = x->shared_LB;
+        if (good && i % 2 == 1) good = furini_worker_init(s, s);
+        if (!good) {
+            if (used > 0) { s->amat = NULL; s->adj16 = NULL; }
+            bb_free(s);
+            if (used == 0) { amat = NULL; adj16 = NULL; ok = 0; }
+            continue;
+        }
+        bb_shuffle_ties(s, (unsigned)(i / 2));
+        ex[used] = (i % 2 == 0) ? sewell_explore : furini_explore;
+        ws[used] = s;
+        member[used++] = i;
+    }
+    if (used > 0) ws[0]->progress = progress;
+
+    *out_LB      = LB;
+    *out_UB_init = ub_init;
+
+    int winner = -1, K = ub_init, timeout = 0;
+    long nodes = 0, cuts = 0;
+    if (used > 0 && n > 0 && LB < ub_init) {
+        winner  = par_portfolio(ws, ex, used);
+        if (winner >= 0) winner = member[winner];
+        K       = ws[0]->UB;
+        nodes   = ws[0]->nodes_visited;
+        cuts    = ws[0]->branches_cut;
+        timeout = ws[0]->timeout;
+        BB_STAT(bb_stats_flush(ws[0]));
+    }
+
+    *out_K       = K;
+    *out_optimal = (winner >= 0 || K == LB) && !timeout;
+    *out_nodes   = nodes;
+    *out_cuts    = cuts;
+    *out_time    = now_s() - t0;
+    *out_timeout = timeout;
+    *out_backend = amat ? ADJ_BITSET : ADJ_CSR;
+    if (x->out_winner) *x->out_winner = winner;
+    if (x->out_searched) *x->out_searched = used > 0;
+
+    for (int i = used - 1; i >= 0; i--) {
+        if (i > 0) { ws[i]->amat = NULL; ws[i]->adj16 = NULL; }
+        bb_free(ws[i]);
+    }
+    if (used == 0) { free(amat); free(adj16); }
+    return used == 0 && ub_init > BB_MAX_COLORS && LB < ub_init ? BB_ERR_COLORS : 1;
+}
+
+/* ── Public solver ─────────────────────────────────────────────────────
+ * Same contract as sewell_solve() plus n_threads (clamped to
+ * [2, PORTFOLIO_MAX]) and out_winner: index of the member that proved
+ * optimality, -1 if none did. Searches the kernel of the graph (see
+ * reduce.h).
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT int portfolio_solve(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress, const int* cancel,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_cancelled, int* out_backend,
+    int n_threads, int* out_winner
+) {
+    BBStart x;
+    memset(&x, 0, sizeof(x));
+    x.out_winner = out_winner;
+    x.cancel = cancel;
+    int st = reduced_solve(solve, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts, out_time,
+                           out_timeout, out_backend, n_threads, &x);
+    *out_cancelled = bb_was_cancelled(cancel, *out_timeout);
+    return st;
+}
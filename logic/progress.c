@@ -0,0 +1,50 @@
+/*
+ * progress.c
+ * ──────────
+ * Reader side of the progress ring (see coloring.h). The solver thread
+ * only ever runs progress_push(); a poller copies records out whenever
+ * it likes, so the search never waits on (or calls into) its observer.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+
+EXPORT ProgressRing* progress_ring_new(void) {
+    return (ProgressRing*)calloc(1, sizeof(ProgressRing));
+}
+
+EXPORT void progress_ring_free(ProgressRing* r) {
+    free(r);
+}
+
+EXPORT int progress_ring_read(const ProgressRing* r, uint64_t* cursor,
+                              ProgressRec* out, int max) {
+    uint64_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    uint64_t i    = *cursor;
+    if (head - i > PROGRESS_RING_CAP) i = head - PROGRESS_RING_CAP;   /* lapped */
+
+    int got = 0;
+    for (; i < head && got < max; i++) {
+        const ProgressRec* e = &r->rec[i & (PROGRESS_RING_CAP - 1)];
+        uint64_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        memcpy(&out[got], e, sizeof(ProgressRec));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        /* Rewritten under us (or not this record any more): drop it */
+        if (seq != 2 * i + 2 || __atomic_load_n(&e->seq, __ATOMIC_RELAXED) != seq)
+            continue;
+        got++;
+    }
+    *cursor = i;
+    return got;
+}
+
+EXPORT int progress_ring_stats(const ProgressRing* r, BBStats* out) {
+#ifdef BB_STATS
+    memcpy(out, &r->stats, sizeof(*out));
+    return 1;
+#else
+    (void)r; (void)out;
+    return 0;
+#endif
+}
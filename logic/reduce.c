@@ -0,0 +1,370 @@
+/*
+ * reduce.c
+ * ────────
+ * Kernelization pre-pass (see reduce.h) and the engine-independent
+ * solve front end: relabel, kernelize, split into blocks, then core.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "heuristics.h"
+#include "reduce.h"
+#include "blocks.h"
+#include "relabel.h"
+
+static int reduce_on = 1;
+
+EXPORT void bb_set_reduce(int on) { reduce_on = on != 0; }
+
+/* Containment-test work allowed for the domination rule, per CSR entry */
+#define DOMINATE_WORK_PER_ENTRY  32
+
+typedef struct {
+    int        n;
+    const int* adj;
+    const int* start;
+    const int* deg;
+    int        lb;
+
+    char* alive;
+    int*  cdeg;         /* degree among alive vertices                  */
+    int*  queue;        /* alive vertices whose cdeg fell below lb      */
+    int   qn;
+    int*  mark;         /* stamp: neighbours of the vertex under test   */
+    int   stamp;
+
+    int*  order;
+    int*  rep;
+    int   removed;
+} Reducer;
+
+static void drop(Reducer* r, int v, int rep) {
+    r->alive[v] = 0;
+    r->order[r->removed] = v;
+    r->rep[r->removed++] = rep;
+    for (int j = r->start[v]; j < r->start[v] + r->deg[v]; j++) {
+        int w = r->adj[j];
+        if (r->alive[w] && --r->cdeg[w] == r->lb - 1) r->queue[r->qn++] = w;
+    }
+}
+
+static void peel(Reducer* r) {
+    while (r->qn > 0) {
+        int v = r->queue[--r->qn];
+        if (r->alive[v]) drop(r, v, -1);
+    }
+}
+
+/* ── Alive u ≠ v, not adjacent to v, with N(v) ⊆ N(u); -1 if none ────
+ * Every such u neighbours v's lowest-degree neighbour w, so only N(w)
+ * is scanned.
+ * ─────────────────────────────────────────────────────────────────── */
+static int dominator(Reducer* r, int v, long* work) {
+    const int* adj = r->adj;
+    int sv = r->start[v], dv = r->deg[v];
+    int w = -1;
+    r->stamp++;
+    *work += dv;
+    for (int j = sv; j < sv + dv; j++) {
+        int x = adj[j];
+        if (!r->alive[x]) continue;
+        r->mark[x] = r->stamp;
+        if (w < 0 || r->cdeg[x] < r->cdeg[w]) w = x;
+    }
+    if (w < 0) return -1;
+
+    for (int i = r->start[w]; i < r->start[w] + r->deg[w]; i++) {
+        int u = adj[i];
+        (*work)++;
+        if (u == v || !r->alive[u] || r->mark[u] == r->stamp || r->cdeg[u] < r->cdeg[v])
+            continue;
+        int ok = 1;
+        for (int j = sv; j < sv + dv && ok; j++) {
+            int x = adj[j];
+            if (r->alive[x] && x != w) ok = adj_has(adj, r->start[u], r->deg[u], x);
+        }
+        *work += dv;
+        if (ok) return u;
+    }
+    return -1;
+}
+
+int kernel_build(int n, const int* adj, const int* start, const int* deg,
+                 int lb, Kernel* k) {
+    memset(k, 0, sizeof(*k));
+    long entries = n > 0 ? (long)start[n - 1] + deg[n - 1] : 0;
+
+    Reducer r;
+    memset(&r, 0, sizeof(r));
+    r.n = n; r.adj = adj; r.start = start; r.deg = deg; r.lb = lb;
+    r.alive = (char*)malloc(n + 1);
+    r.cdeg  = (int*)malloc((n + 1) * sizeof(int));
+    r.queue = (int*)malloc((n + 1) * sizeof(int));
+    r.mark  = (int*)calloc(n + 1, sizeof(int));
+    r.order = (int*)malloc((n + 1) * sizeof(int));
+    r.rep   = (int*)malloc((n + 1) * sizeof(int));
+    int ok = r.alive && r.cdeg && r.queue && r.mark && r.order && r.rep;
+
+    if (ok) {
+        memset(r.alive, 1, n);
+        for (int v = 0; v < n; v++) {
+            r.cdeg[v] = deg[v];
+            if (deg[v] < lb) r.queue[r.qn++] = v;
+        }
+        peel(&r);
+
+        /* Domination sweeps, each followed by the peeling it unlocks */
+        long work = 0, budget = DOMINATE_WORK_PER_ENTRY * (entries + n);
+        for (int changed = 1; changed && work < budget; ) {
+            changed = 0;
+            for (int v = 0; v < n && work < budget; v++) {
+                if (!r.alive[v]) continue;
+                int u = dominator(&r, v, &work);
+                if (u < 0) continue;
+                drop(&r, v, u);
+                peel(&r);
+                changed = 1;
+            }
+        }
+    }
+
+    /* Induced kernel on the survivors, renumbered in index order so
+       every row stays sorted */
+    int* id = r.queue;               /* reused: input vertex → kernel id */
+    if (ok) {
+        k->n = n - r.removed;
+        k->orig  = (int*)malloc((k->n + 1) * sizeof(int));
+        k->start = (int*)malloc((k->n + 1) * sizeof(int));
+        k->deg   = (int*)malloc((k->n + 1) * sizeof(int));
+        ok = k->orig && k->start && k->deg;
+    }
+    if (ok) {
+        long kentries = 0;
+        for (int v = 0, i = 0; v < n; v++) {
+            id[v] = r.alive[v] ? i : -1;
+            if (!r.alive[v]) continue;
+            k->orig[i] = v;
+            k->start[i] = (int)kentries;
+            k->deg[i] = r.cdeg[v];
+            kentries += r.cdeg[v];
+            i++;
+        }
+        k->adj = (int*)malloc((kentries + 1) * sizeof(int));
+        ok = k->adj != NULL;
+        for (int i = 0; ok && i < k->n; i++) {
+            int v = k->orig[i], p = k->start[i];
+            for (int j = start[v]; j < start[v] + deg[v]; j++)
+                if (r.alive[adj[j]]) k->adj[p++] = id[adj[j]];
+        }
+    }
+
+    free(r.alive); free(r.cdeg); free(r.queue); free(r.mark);
+    if (!ok) {
+        free(r.order); free(r.rep);
+        kernel_free(k);
+        return 0;
+    }
+    k->removed = r.removed;
+    k->order   = r.order;
+    k->rep     = r.rep;
+    return 1;
+}
+
+void kernel_lift(const Kernel* k, int n, const int* adj, const int* start,
+                 const int* deg, const int* kcolor, int* seen, int* out_coloring) {
+    for (int v = 0; v < n; v++) out_coloring[v] = -1;
+    for (int i = 0; i < k->n; i++) out_coloring[k->orig[i]] = kcolor[i];
+
+    /* Reverse removal order: the coloured vertices are exactly the graph
+       each removed vertex was taken out of */
+    memset(seen, 0, (n + 2) * sizeof(int));
+    for (int i = k->removed - 1; i >= 0; i--) {
+        int v = k->order[i];
+        if (k->rep[i] >= 0) {
+            out_coloring[v] = out_coloring[k->rep[i]];
+            continue;
+        }
+        /* colours ≤ deg(v) cover a free one; seen[] stamps with i + 1 */
+        for (int j = start[v]; j < start[v] + deg[v]; j++) {
+            int c = out_coloring[adj[j]];
+            if (c >= 0 && c <= deg[v]) seen[c] = i + 1;
+        }
+        int c = 0;
+        while (seen[c] == i + 1) c++;
+        out_coloring[v] = c;
+    }
+}
+
+void kernel_free(Kernel* k) {
+    free(k->adj); free(k->start); free(k->deg); free(k->orig);
+    free(k->order); free(k->rep);
+    memset(k, 0, sizeof(*k));
+}
+
+/* ── core() on G, or block by block when G has more than one ──────── */
+static int split_solve(BBSolveFn core,
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x) {
+    Blocks b;
+    int ok = 0;
+    if (blocks_build(n, adj, start, deg, &b)) {
+        if (b.nblocks > 1)
+            ok = blocks_solve(core, &b, n, adj, start, deg, temps_max, progress,
+                              out_K, out_coloring, out_LB, out_UB_init, out_optimal,
+                              out_nodes, out_cuts, out_time, out_timeout, out_backend,
+                              n_threads, x);
+        blocks_free(&b);
+    }
+    if (ok) return ok;
+    return core(n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                out_time, out_timeout, out_backend, n_threads, x);
+}
+
+/* ── core() on the kernel of G, split into blocks ──────────────────── */
+static int kernel_solve(BBSolveFn core,
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x) {
+    double t0 = now_s();
+    int lb = greedy_clique(n, adj, start, deg);
+    if (x->known_LB > lb) lb = x->known_LB;
+
+    Kernel k;
+    int*   kcolor = NULL;
+    int*   kwarm  = NULL;
+    int*   seen   = NULL;
+    int    built  = kernel_build(n, adj, start, deg, lb, &k);
+    if (built && k.removed > 0) {
+        kcolor = (int*)malloc((k.n + 1) * sizeof(int));
+        seen   = (int*)malloc((n + 2) * sizeof(int));
+        if (x->warm_coloring) kwarm = (int*)malloc((k.n + 1) * sizeof(int));
+    }
+    if (!built || k.removed == 0 || !kcolor || !seen || (x->warm_coloring && !kwarm)) {
+        free(kcolor); free(kwarm); free(seen);
+        if (built) kernel_free(&k);
+        return split_solve(core, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                           out_time, out_timeout, out_backend, n_threads, x);
+    }
+
+    /* The kernel solve may stop as soon as it meets lb: any colouring
+       of the kernel with ≤ lb colours lifts to an optimum of G */
+    BBStart kx = *x;
+    kx.known_LB = lb;
+    if (kwarm) {
+        for (int i = 0; i < k.n; i++) kwarm[i] = x->warm_coloring[k.orig[i]];
+        kx.warm_coloring = kwarm;
+    }
+
+    int kK = 0, kLB = lb, kUBi = 0, kopt = 1, ktout = 0, kback = ADJ_CSR;
+    long knodes = 0, kcuts = 0;
+    double ktime = 0.0;
+    int    st    = 1;
+    if (k.n > 0) {
+        st = split_solve(core, k.n, k.adj, k.start, k.deg, temps_max, progress, &kK, kcolor,
+                         &kLB, &kUBi, &kopt, &knodes, &kcuts, &ktime, &ktout, &kback,
+                         n_threads, &kx);
+    } else if (x->out_winner) {
+        *x->out_winner = -1;
+    }
+    kernel_lift(&k, n, adj, start, deg, kcolor, seen, out_coloring);
+
+    int K = 0;
+    for (int v = 0; v < n; v++) if (out_coloring[v] + 1 > K) K = out_coloring[v] + 1;
+    int LB = kLB > lb ? kLB : lb;
+
+    *out_K       = K;
+    *out_LB      = LB;
+    *out_UB_init = kUBi > lb ? kUBi : lb;
+    *out_optimal = (kopt || K == LB) && !ktout;
+    *out_nodes   = knodes;
+    *out_cuts    = kcuts;
+    *out_time    = now_s() - t0;
+    *out_timeout = ktout;
+    *out_backend = kback;
+
+    free(kcolor); free(kwarm); free(seen);
+    kernel_free(&k);
+    return st < 0 && K > LB ? st : 1;
+}
+
+/* ── Reduction when on, else core() on G as given ──────────────────── */
+static int front_solve(BBSolveFn core,
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x) {
+    if (!reduce_on)
+        return core(n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                    out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                    out_time, out_timeout, out_backend, n_threads, x);
+    return kernel_solve(core, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                        out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                        out_time, out_timeout, out_backend, n_threads, x);
+}
+
+int reduced_solve(BBSolveFn core,
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x) {
+    static const BBStart cold;
+    if (!x) x = &cold;
+    if (n <= 0 || x->ckpt || x->out_ckpt_len)
+        return core(n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                    out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                    out_time, out_timeout, out_backend, n_threads, x);
+
+    /* Relabel first: the kernel and the blocks keep relative vertex
+       order, so they inherit the locality of the new numbering */
+    double  t0   = now_s();
+    int     mode = bb_relabel_mode();
+    Relabel rl;
+    int*    rcolor = NULL;
+    int*    rwarm  = NULL;
+    if (mode != RELABEL_NONE && relabel_build(mode, n, adj, start, deg, &rl)) {
+        rcolor = (int*)malloc((n + 1) * sizeof(int));
+        if (x->warm_coloring) rwarm = (int*)malloc((n + 1) * sizeof(int));
+        if (!rcolor || (x->warm_coloring && !rwarm)) {
+            free(rcolor); free(rwarm);
+            rcolor = NULL;
+            relabel_free(&rl);
+        }
+    }
+    if (!rcolor)
+        return front_solve(core, n, adj, start, deg, temps_max, progress, out_K, out_coloring,
+                           out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                           out_time, out_timeout, out_backend, n_threads, x);
+
+    BBStart rx = *x;
+    if (rwarm) {
+        for (int i = 0; i < n; i++) rwarm[i] = x->warm_coloring[rl.old_of[i]];
+        rx.warm_coloring = rwarm;
+    }
+    int ret = front_solve(core, rl.n, rl.adj, rl.start, rl.deg, temps_max, progress, out_K,
+                          rcolor, out_LB, out_UB_init, out_optimal, out_nodes, out_cuts,
+                          out_time, out_timeout, out_backend, n_threads, &rx);
+    for (int i = 0; i < n; i++) out_coloring[rl.old_of[i]] = rcolor[i];
+    *out_time = now_s() - t0;
+
+    free(rcolor); free(rwarm);
+    relabel_free(&rl);
+    return ret;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#ifndef REDUCE_H
+#define REDUCE_H
+
+/*
+ * reduce.h
+ * ────────
+ * Kernelization before the B&B. Two rules are applied until neither
+ * fires, each on the graph left by the previous removals:
+ *
+ *   low degree : deg(v) < LB (a clique size, so LB ≤ χ). v gets a free
+ *                colour among its neighbours once they are coloured,
+ *                and that never needs more than LB colours.
+ *   dominated  : u not adjacent to v with N(v) ⊆ N(u). v copies u's
+ *                colour, which none of its neighbours can hold.
+ *
+ * The engines search the induced kernel. kernel_lift() re-inserts the
+ * removed vertices in reverse order, and the lifted colouring uses
+ * max(K_kernel, LB) colours, so χ(G) = max(χ(kernel), LB) and a
+ * kernel optimum is an optimum of G.
+ */
+
+#include "coloring.h"
+
+typedef struct {
+    int  n;             /* kernel vertices                              */
+    int* adj;           /* kernel CSR, sorted rows (owned)              */
+    int* start;
+    int* deg;
+    int* orig;          /* kernel vertex → vertex of the input graph    */
+
+    int  removed;       /* removed vertices, in removal order:          */
+    int* order;         /*   order[i]                                   */
+    int* rep;           /*   vertex whose colour it copies, -1 = greedy */
+} Kernel;
+
+/* ── Reduce G with lower bound lb ──────────────────────────────────────
+ * Returns 0 on allocation failure (k left empty). The domination rule
+ * stops early on dense graphs, where its containment tests would cost
+ * more than the B&B they save.
+ * ─────────────────────────────────────────────────────────────────── */
+int  kernel_build(int n, const int* adj, const int* start, const int* deg,
+                  int lb, Kernel* k);
+
+/* ── Colouring of G from kcolor[k->n] (a proper kernel colouring) ────
+ * seen: scratch of n + 2 ints.
+ * ─────────────────────────────────────────────────────────────────── */
+void kernel_lift(const Kernel* k, int n, const int* adj, const int* start,
+                 const int* deg, const int* kcolor, int* seen, int* out_coloring);
+
+void kernel_free(Kernel* k);
+
+/* ── Kernelization and the block split (blocks.h) off / on for later
+ * solves (default on)
+ * ─────────────────────────────────────────────────────────────────── */
+EXPORT void bb_set_reduce(int on);
+
+/* ── An engine's full solve on one graph (static solve() of each) ──── */
+typedef int (*BBSolveFn)(
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x);
+
+/* ── core() on the kernel of G, outputs lifted back to G ───────────────
+ * Same contract as core. G is first relabeled when bb_set_relabel()
+ * asks for it (relabel.h). The kernel (G itself when nothing reduces)
+ * is solved block by block (blocks_solve()) when it has several. Runs
+ * core on G as given when x resumes or writes a checkpoint (those are
+ * bound to the graph they were taken on).
+ * ─────────────────────────────────────────────────────────────────── */
+int reduced_solve(BBSolveFn core,
+    int n, int* adj, int* start, int* deg,
+    int temps_max, ProgressRing* progress,
+    int* out_K, int* out_coloring,
+    int* out_LB, int* out_UB_init,
+    int* out_optimal, long* out_nodes, long* out_cuts,
+    double* out_time, int* out_timeout, int* out_backend, int n_threads,
+    const BBStart* x);
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * relabel.c
+ * ─────────
+ * Locality orders of the vertices (see relabel.h) and the relabeled CSR.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "coloring.h"
+#include "relabel.h"
+
+static int relabel_mode = RELABEL_NONE;
+
+EXPORT void bb_set_relabel(int mode) {
+    relabel_mode = mode >= RELABEL_NONE && mode <= RELABEL_BFS ? mode : RELABEL_NONE;
+}
+
+int bb_relabel_mode(void) { return relabel_mode; }
+
+/* ── Degeneracy: smallest-last removal through degree buckets, reversed
+ * O(n + m). bucket[d] is a doubly linked list of vertices of current
+ * degree d.
+ * ─────────────────────────────────────────────────────────────────── */
+static int order_degeneracy(int n, const int* adj, const int* start, const int* deg,
+                            int* order) {
+    int max_deg = 0;
+    for (int v = 0; v < n; v++) if (deg[v] > max_deg) max_deg = deg[v];
+    int* cur  = (int*)malloc((n + 1) * sizeof(int));
+    int* next = (int*)malloc((n + 1) * sizeof(int));
+    int* prev = (int*)malloc((n + 1) * sizeof(int));
+    int* head = (int*)malloc((max_deg + 1) * sizeof(int));
+    int ok = cur && next && prev && head;
+    if (ok) {
+        for (int d = 0; d <= max_deg; d++) head[d] = -1;
+        for (int v = n - 1; v >= 0; v--) {
+            cur[v] = deg[v]; prev[v] = -1; next[v] = head[deg[v]];
+            if (next[v] >= 0) prev[next[v]] = v;
+            head[deg[v]] = v;
+        }
+        int d = 0;
+        for (int i = n - 1; i >= 0; i--) {
+            if (d > 0) d--;                 /* a removal lowers degrees by ≤ 1 */
+            while (head[d] < 0) d++;
+            int v = head[d];
+            head[d] = next[v];
+            if (next[v] >= 0) prev[next[v]] = -1;
+            cur[v] = -1;
+            order[i] = v;
+            for (int j = start[v]; j < start[v] + deg[v]; j++) {
+                int w = adj[j], c = cur[w];
+                if (c < 0) continue;
+                /* unlink w from bucket c, push it on bucket c - 1 */
+                if (prev[w] >= 0) next[prev[w]] = next[w]; else head[c] = next[w];
+                if (next[w] >= 0) prev[next[w]] = prev[w];
+                cur[w] = --c;
+                prev[w] = -1; next[w] = head[c];
+                if (next[w] >= 0) prev[next[w]] = w;
+                head[c] = w;
+            }
+        }
+    }
+    free(cur); free(next); free(prev); free(head);
+    return ok;
+}
+
+/* (degree, vertex) packed for qsort: no comparator context needed */
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* ── Cuthill–McKee style BFS, one component after another ──────────────
+ * up = 1: roots of min degree, neighbours by increasing degree.
+ * up = 0: roots of max degree, neighbours by decreasing degree.
+ * ─────────────────────────────────────────────────────────────────── */
+static int order_bfs(int n, const int* adj, const int* start, const int* deg,
+                     int up, int* order) {
+    int max_deg = 0;
+    for (int v = 0; v < n; v++) if (deg[v] > max_deg) max_deg = deg[v];
+    char*     seen  = (char*)calloc(n + 1, 1);
+    int*      roots = (int*)malloc((n + 1) * sizeof(int));
+    uint64_t* key   = (uint64_t*)malloc(((size_t)(n > max_deg ? n : max_deg) + 1) * sizeof(uint64_t));
+    int ok = seen && roots && key;
+    if (ok) {
+        /* Root candidates by degree, ties by index */
+        for (int v = 0; v < n; v++)
+            key[v] = ((uint64_t)(up ? deg[v] : max_deg - deg[v]) << 32) | (uint32_t)v;
+        qsort(key, n, sizeof(uint64_t), cmp_u64);
+        for (int i = 0; i < n; i++) roots[i] = (int)(key[i] & 0xffffffffu);
+
+        int tail = 0;
+        for (int r = 0; r < n; r++) {
+            if (seen[roots[r]]) continue;
+            int head = tail;
+            seen[roots[r]] = 1;
+            order[tail++] = roots[r];
+            while (head < tail) {
+                int v = order[head++], k = 0;
+                for (int j = start[v]; j < start[v] + deg[v]; j++) {
+                    int w = adj[j];
+                    if (seen[w]) continue;
+                    seen[w] = 1;
+                    key[k++] = ((uint64_t)(up ? deg[w] : max_deg - deg[w]) << 32) | (uint32_t)w;
+                }
+                qsort(key, k, sizeof(uint64_t), cmp_u64);
+                for (int i = 0; i < k; i++) order[tail++] = (int)(key[i] & 0xffffffffu);
+            }
+        }
+    }
+    free(seen); free(roots); free(key);
+    return ok;
+}
+
+int relabel_build(int mode, int n, const int* adj, const int* start, const int* deg,
+                  Relabel* r) {
+    memset(r, 0, sizeof(*r));
+    long entries = n > 0 ? (long)start[n - 1] + deg[n - 1] : 0;
+    int* old_of = (int*)malloc((n + 1) * sizeof(int));
+    int* new_of = (int*)malloc((n + 1) * sizeof(int));
+    int ok = old_of && new_of;
+
+    if (ok) {
+        switch (mode) {
+        case RELABEL_DEGENERACY: ok = order_degeneracy(n, adj, start, deg, old_of); break;
+        case RELABEL_RCM:        ok = order_bfs(n, adj, start, deg, 1, old_of);     break;
+        case RELABEL_BFS:        ok = order_bfs(n, adj, start, deg, 0, old_of);     break;
+        default:                 ok = 0;
+        }
+    }
+    if (ok && mode == RELABEL_RCM) {
+        for (int i = 0, j = n - 1; i < j; i++, j--) {
+            int t = old_of[i]; old_of[i] = old_of[j]; old_of[j] = t;
+        }
+    }
+
+    if (ok) {
+        r->n      = n;
+        r->old_of = old_of;
+        r->start  = (int*)malloc((n + 1) * sizeof(int));
+        r->deg    = (int*)malloc((n + 1) * sizeof(int));
+        r->adj    = (int*)malloc((entries + 1) * sizeof(int));
+        ok = r->start && r->deg && r->adj;
+    }
+    if (ok) {
+        long pos = 0;
+        for (int i = 0; i < n; i++) {
+            new_of[old_of[i]] = i;
+            r->deg[i]   = deg[old_of[i]];
+            r->start[i] = (int)pos;
+            pos += r->deg[i];
+        }
+        /* Appending u to its neighbours' rows in increasing u leaves
+           every row sorted; deg[] is the fill cursor meanwhile */
+        for (int i = 0; i < n; i++) r->deg[i] = 0;
+        for (int u = 0; u < n; u++) {
+            int v = old_of[u];
+            for (int j = start[v]; j < start[v] + deg[v]; j++) {
+                int w = new_of[adj[j]];
+                r->adj[r->start[w] + r->deg[w]++] = u;
+            }
+        }
+    }
+
+    free(new_of);
+    if (!ok) {
+        if (r->old_of) relabel_free(r); else free(old_of);
+        memset(r, 0, sizeof(*r));
+        return 0;
+    }
+    return 1;
+}
+
+void relabel_free(Relabel* r) {
+    free(r->adj); free(r->start); free(r->deg); free(r->old_of);
+    memset(r, 0, sizeof(*r));
+}
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef RELABEL_H
+#define RELABEL_H
+
+/*
+ * relabel.h
+ * ─────────
+ * Locality relabeling of the CSR before the B&B. The file's numbering
+ * scatters a vertex's neighbours over color[], the DSATUR levels and
+ * the colour sets. colorier() / decolorier() touch each of them per
+ * neighbour, so on large graphs most of those accesses miss the cache.
+ * A permutation that keeps neighbours close in index keeps them close
+ * in memory:
+ *
+ *   RELABEL_DEGENERACY : reverse smallest-last order. The densest core
+ *                        comes first; DSATUR colours it first.
+ *   RELABEL_RCM        : reverse Cuthill–McKee. BFS from a min-degree
+ *                        vertex with neighbours by increasing degree,
+ *                        reversed. It keeps the CSR bandwidth small.
+ *   RELABEL_BFS        : BFS from a max-degree vertex, neighbours by
+ *                        decreasing degree. DSATUR's first vertex and
+ *                        the region it grows from end up adjacent.
+ *
+ * Index order breaks DSATUR ties, so a relabeled search visits the same
+ * tree in a different order. K and optimality are unaffected; node
+ * counts and times are not.
+ */
+
+#include "coloring.h"
+
+#define RELABEL_NONE        0
+#define RELABEL_DEGENERACY  1
+#define RELABEL_RCM         2
+#define RELABEL_BFS         3
+
+typedef struct {
+    int  n;
+    int* adj;           /* relabeled CSR, sorted rows (owned)           */
+    int* start;
+    int* deg;
+    int* old_of;        /* new vertex → input vertex                    */
+} Relabel;
+
+/* ── Relabeled copy of G in the given order (RELABEL_*) ────────────────
+ * Returns 0 on allocation failure or an unknown mode (r left empty).
+ * ─────────────────────────────────────────────────────────────────── */
+int  relabel_build(int mode, int n, const int* adj, const int* start, const int* deg,
+                   Relabel* r);
+void relabel_free(Relabel* r);
+
+/* ── Relabeling mode of later solves (default RELABEL_NONE) ────────── */
+EXPORT void bb_set_relabel(int mode);
+int         bb_relabel_mode(void);
+
+#endif
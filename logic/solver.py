@@ -5,23 +5,57 @@ Auto-compiles the C shared library on first import, then exposes:
 
     solve_sewell(graph_data, temps_max, live_state=None) -> dict
     solve_furini(graph_data, temps_max, live_state=None) -> dict
+    solve_sewell_parallel(graph_data, temps_max, n_threads=None, live_state=None)
+    solve_furini_parallel(graph_data, temps_max, n_threads=None, live_state=None)
+    solve_portfolio(graph_data, temps_max, n_threads=None, live_state=None)
+    solve_resumable(algo, graph_data, temps_max, checkpoint=None, live_state=None)
+    solve_warm(algo, graph_data, temps_max, warm_coloring=None, known_LB=0, live_state=None)
+    solve_backjump(algo, graph_data, temps_max, nogoods=True, live_state=None)
+    solve_batch(graphs, algo, temps_max, n_threads=None) -> list[dict]
+    DynamicGraph(graph_data=None)   edge / vertex updates + incremental solve()
+    graph_fingerprint(graph_data) -> str
+    cancel()
+    set_presolve_share(share)
+    set_clique_share(share)
+    set_reduce(on)
+    set_relabel(mode)
+    set_frac_lb(depth, share=None)
+    max_clique(graph_data, time_limit=0.0) -> (size, exact)
 
-graph_data is the dict returned by logic.graph.parse_dimacs().
-live_state is an optional shared dict updated every 500 B&B nodes
-(used by the live race panel in the UI).
+graph_data is the dict returned by logic.graph.parse_dimacs(). Its
+adj_flat / start / deg may be lists or any buffer of C ints (numpy.int32,
+array('i')); contiguous int buffers are handed to C without a copy.
+res["coloriage"] is a numpy.int32 array over the C output buffer when
+numpy is installed, a list otherwise.
+live_state is an optional shared dict refreshed every _POLL_S seconds
+from the solver's progress ring (used by the live race panel in the UI);
+no Python code runs on the solver thread while it searches.
 
 The C library is compiled once into:
     logic/coloring.dll   (Windows)
     logic/coloring.so    (Linux / macOS)
 
+With COLORING_STATS=1 in the environment it is built with -DBB_STATS
+into coloring_stats.{dll,so} instead, and every result dict gains
+res["stats"]: cycles per search phase, nodes and prunes per depth and a
+branching histogram (see BBStats in coloring.h and _stats_dict below).
+The instrumented build is slower; the default one carries none of it.
+
 Requirements: gcc must be on PATH.
 """
 
+import array
 import ctypes
 import os
 import platform
 import subprocess
 import sys
+import threading
+
+try:
+    import numpy as _np
+except ImportError:   # optional: plain lists / array('i') still work
+    _np = None
 
 # ── Locate the logic directory ────────────────────────────────────────────
 
@@ -29,12 +63,41 @@ _HERE = os.path.dirname(os.path.abspath(__file__))
 
 _C_SOURCES = [
     os.path.join(_HERE, "heuristics.c"),
+    os.path.join(_HERE, "clique.c"),
+    os.path.join(_HERE, "progress.c"),
+    os.path.join(_HERE, "reduce.c"),
+    os.path.join(_HERE, "relabel.c"),
+    os.path.join(_HERE, "blocks.c"),
     os.path.join(_HERE, "bb_sewell.c"),
     os.path.join(_HERE, "bb_furini.c"),
+    os.path.join(_HERE, "parallel.c"),
+    os.path.join(_HERE, "portfolio.c"),
+    os.path.join(_HERE, "checkpoint.c"),
+    os.path.join(_HERE, "loader.c"),
+    os.path.join(_HERE, "batch.c"),
+    os.path.join(_HERE, "dynamic.c"),
+    os.path.join(_HERE, "frac.c"),
+    os.path.join(_HERE, "backjump.c"),
+]
+
+_C_HEADERS = [
+    os.path.join(_HERE, "coloring.h"),
+    os.path.join(_HERE, "heuristics.h"),
+    os.path.join(_HERE, "clique.h"),
+    os.path.join(_HERE, "parallel.h"),
+    os.path.join(_HERE, "checkpoint.h"),
+    os.path.join(_HERE, "reduce.h"),
+    os.path.join(_HERE, "relabel.h"),
+    os.path.join(_HERE, "blocks.h"),
+    os.path.join(_HERE, "batch.h"),
+    os.path.join(_HERE, "dynamic.h"),
+    os.path.join(_HERE, "frac.h"),
+    os.path.join(_HERE, "backjump.h"),
 ]
 
 _IS_WINDOWS = platform.system() == "Windows"
-_LIB_NAME   = "coloring.dll" if _IS_WINDOWS else "coloring.so"
+_STATS      = os.environ.get("COLORING_STATS", "") not in ("", "0")
+_LIB_NAME   = ("coloring_stats" if _STATS else "coloring") + (".dll" if _IS_WINDOWS else ".so")
 _LIB_PATH   = os.path.join(_HERE, _LIB_NAME)
 
 
@@ -44,8 +107,9 @@ def _compile():
     """Compile C sources into a shared library. Raises RuntimeError on failure."""
     flags = [
         "gcc", "-O2", "-std=c99",
+        *(["-DBB_STATS"] if _STATS else []),
         "-shared",
-        *(["-static-libgcc"] if _IS_WINDOWS else ["-fPIC"]),
+        *(["-static-libgcc"] if _IS_WINDOWS else ["-fPIC", "-pthread"]),
         "-I", _HERE,
         "-o", _LIB_PATH,
         *_C_SOURCES,
@@ -70,8 +134,7 @@ def _needs_recompile() -> bool:
     if not os.path.exists(_LIB_PATH):
         return True
     lib_mtime = os.path.getmtime(_LIB_PATH)
-    for src in _C_SOURCES + [os.path.join(_HERE, "coloring.h"),
-                               os.path.join(_HERE, "heuristics.h")]:
+    for src in _C_SOURCES + _C_HEADERS:
         if os.path.exists(src) and os.path.getmtime(src) > lib_mtime:
             return True
     return False
@@ -87,27 +150,31 @@ def _load_lib() -> ctypes.CDLL:
     except OSError as e:
         raise RuntimeError(f"Cannot load compiled library: {e}")
 
-    # ── Progress callback type ─────────────────────────────────────────
-    # void (*ProgressCB)(long nodes, int UB, int LB, double t, long cuts)
-    global _CB_TYPE
-    _CB_TYPE = ctypes.CFUNCTYPE(
-        None,
-        ctypes.c_long,   # nodes
-        ctypes.c_int,    # UB
-        ctypes.c_int,    # LB
-        ctypes.c_double, # t
-        ctypes.c_long,   # cuts
-    )
-
-    # ── sewell_solve signature ─────────────────────────────────────────
-    lib.sewell_solve.restype  = None
+    # ── Progress ring (coloring.h) ─────────────────────────────────────
+    lib.progress_ring_new.restype   = ctypes.c_void_p
+    lib.progress_ring_new.argtypes  = []
+    lib.progress_ring_free.restype  = None
+    lib.progress_ring_free.argtypes = [ctypes.c_void_p]
+    lib.progress_ring_stats.restype  = ctypes.c_int
+    lib.progress_ring_stats.argtypes = [ctypes.c_void_p, ctypes.POINTER(_BBStats)]
+    lib.progress_ring_read.restype  = ctypes.c_int
+    lib.progress_ring_read.argtypes = [
+        ctypes.c_void_p,                     # ring
+        ctypes.POINTER(ctypes.c_uint64),     # cursor (in/out)
+        ctypes.POINTER(_ProgressRec),        # out[max]
+        ctypes.c_int,                        # max
+    ]
+
+    # ── sewell_solve signature; 1, or _BB_ERR_COLORS ───────────────────
+    lib.sewell_solve.restype  = ctypes.c_int
     lib.sewell_solve.argtypes = [
         ctypes.c_int,                        # n
         ctypes.POINTER(ctypes.c_int),        # adj
         ctypes.POINTER(ctypes.c_int),        # start
         ctypes.POINTER(ctypes.c_int),        # deg
         ctypes.c_int,                        # temps_max
-        _CB_TYPE,                            # callback
+        ctypes.c_void_p,                     # progress ring (or NULL)
+        ctypes.POINTER(ctypes.c_int),        # cancel token (or NULL)
         ctypes.POINTER(ctypes.c_int),        # out_K
         ctypes.POINTER(ctypes.c_int),        # out_coloring[n]
         ctypes.POINTER(ctypes.c_int),        # out_LB
@@ -117,17 +184,268 @@ def _load_lib() -> ctypes.CDLL:
         ctypes.POINTER(ctypes.c_long),       # out_cuts
         ctypes.POINTER(ctypes.c_double),     # out_time
         ctypes.POINTER(ctypes.c_int),        # out_timeout
+        ctypes.POINTER(ctypes.c_int),        # out_cancelled
+        ctypes.POINTER(ctypes.c_int),        # out_backend (0 CSR, 1 bitset)
     ]
 
     # ── furini_solve signature (identical layout) ──────────────────────
-    lib.furini_solve.restype  = None
+    lib.furini_solve.restype  = ctypes.c_int
     lib.furini_solve.argtypes = lib.sewell_solve.argtypes
 
+    # ── *_solve_parallel: same layout + n_threads ──────────────────────
+    for name in ("sewell_solve_parallel", "furini_solve_parallel"):
+        fn = getattr(lib, name)
+        fn.restype  = ctypes.c_int
+        fn.argtypes = lib.sewell_solve.argtypes + [ctypes.c_int]  # n_threads
+
+    # ── portfolio_solve: + n_threads, out_winner ───────────────────────
+    lib.portfolio_solve.restype  = ctypes.c_int
+    lib.portfolio_solve.argtypes = lib.sewell_solve.argtypes + [
+        ctypes.c_int,                        # n_threads (members)
+        ctypes.POINTER(ctypes.c_int),        # out_winner (-1 = none)
+    ]
+
+    # ── *_resume: + checkpoint in, checkpoint out; int status ─────────
+    for name in ("sewell_resume", "furini_resume"):
+        fn = getattr(lib, name)
+        fn.restype  = ctypes.c_int           # 0 = checkpoint rejected
+        fn.argtypes = lib.sewell_solve.argtypes + [
+            ctypes.c_char_p,                 # ckpt (NULL = fresh run)
+            ctypes.c_int,                    # ckpt_len
+            ctypes.POINTER(ctypes.c_ubyte),  # out_ckpt
+            ctypes.POINTER(ctypes.c_int),    # out_ckpt_len
+        ]
+
+    lib.bb_set_presolve_share.restype  = None
+    lib.bb_set_presolve_share.argtypes = [ctypes.c_double]
+    lib.bb_set_clique_share.restype    = None
+    lib.bb_set_clique_share.argtypes   = [ctypes.c_double]
+    lib.bb_set_reduce.restype          = None
+    lib.bb_set_reduce.argtypes         = [ctypes.c_int]
+    lib.bb_set_relabel.restype         = None
+    lib.bb_set_relabel.argtypes        = [ctypes.c_int]
+    lib.bb_set_frac_depth.restype      = None
+    lib.bb_set_frac_depth.argtypes     = [ctypes.c_int]
+    lib.bb_set_frac_share.restype      = None
+    lib.bb_set_frac_share.argtypes     = [ctypes.c_double]
+
+    lib.bb_cancel.restype  = None
+    lib.bb_cancel.argtypes = [ctypes.POINTER(ctypes.c_int)]   # cancel token
+
+    lib.max_clique.restype  = ctypes.c_int
+    lib.max_clique.argtypes = [
+        ctypes.c_int,                    # n
+        ctypes.POINTER(ctypes.c_int),    # adj_flat
+        ctypes.POINTER(ctypes.c_int),    # start
+        ctypes.POINTER(ctypes.c_int),    # deg
+        ctypes.c_int,                    # lb
+        ctypes.c_int,                    # ub
+        ctypes.c_double,                 # time_limit (s)
+        ctypes.POINTER(ctypes.c_int),    # cancel token (or NULL)
+        ctypes.POINTER(ctypes.c_int),    # out_exact
+    ]
+
+    lib.bb_checkpoint_bytes.restype  = ctypes.c_int
+    lib.bb_checkpoint_bytes.argtypes = [ctypes.c_int]
+
+    # ── *_solve_warm: + warm_UB, warm_coloring, known_LB ───────────────
+    for name in ("sewell_solve_warm", "furini_solve_warm"):
+        fn = getattr(lib, name)
+        fn.restype  = ctypes.c_int
+        fn.argtypes = lib.sewell_solve.argtypes + [
+            ctypes.c_int,                    # warm_UB (0 = none)
+            ctypes.POINTER(ctypes.c_int),    # warm_coloring[n] or NULL
+            ctypes.c_int,                    # known_LB
+        ]
+
+    # ── *_solve_backjump: + mode, out_jumps, out_nogood_cuts ──────────
+    for name in ("sewell_solve_backjump", "furini_solve_backjump"):
+        fn = getattr(lib, name)
+        fn.restype  = ctypes.c_int
+        fn.argtypes = lib.sewell_solve.argtypes + [
+            ctypes.c_int,                    # BB_BACKJUMP | BB_NOGOODS
+            ctypes.POINTER(ctypes.c_long),   # out_jumps
+            ctypes.POINTER(ctypes.c_long),   # out_nogood_cuts
+        ]
+
+    # ── batch_solve (batch.h) ──────────────────────────────────────────
+    lib.batch_solve.restype  = ctypes.c_int  # 0 = bad input / no memory, or _BB_ERR_COLORS
+    lib.batch_solve.argtypes = [
+        ctypes.c_int,                        # algo (BATCH_SEWELL / _FURINI)
+        ctypes.POINTER(ctypes.c_int),        # packed graphs
+        ctypes.c_long,                       # buffer length (ints)
+        ctypes.c_int,                        # n_graphs
+        ctypes.c_int,                        # temps_max (per graph)
+        ctypes.c_int,                        # n_threads
+        ctypes.POINTER(ctypes.c_int),        # cancel token (or NULL)
+        ctypes.POINTER(_BatchResult),        # out[n_graphs]
+        ctypes.POINTER(ctypes.c_int),        # out_colorings[sum n]
+    ]
+
+    # ── Dynamic graph handle (dynamic.h) ───────────────────────────────
+    lib.dyn_new.restype  = ctypes.c_void_p
+    lib.dyn_new.argtypes = [
+        ctypes.c_int,                        # n
+        ctypes.POINTER(ctypes.c_int),        # adj
+        ctypes.POINTER(ctypes.c_int),        # start
+        ctypes.POINTER(ctypes.c_int),        # deg
+    ]
+    lib.dyn_free.restype      = None
+    lib.dyn_free.argtypes     = [ctypes.c_void_p]
+    lib.dyn_vertices.restype  = ctypes.c_int
+    lib.dyn_vertices.argtypes = [ctypes.c_void_p]
+    for fn in (lib.dyn_add_edge, lib.dyn_remove_edge):
+        fn.restype  = ctypes.c_int           # 1 done / 0 no-op / -1 error
+        fn.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+    lib.dyn_add_vertex.restype     = ctypes.c_int
+    lib.dyn_add_vertex.argtypes    = [ctypes.c_void_p]
+    lib.dyn_remove_vertex.restype  = ctypes.c_int
+    lib.dyn_remove_vertex.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.dyn_seed.restype  = ctypes.c_int     # 0 = colouring not proper
+    lib.dyn_seed.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.c_int]
+    lib.dyn_solve.restype  = ctypes.c_int    # 0 = bad algo / no memory, or _BB_ERR_COLORS
+    lib.dyn_solve.argtypes = [
+        ctypes.c_void_p,                     # DynGraph*
+        ctypes.c_int,                        # algo (DYN_SEWELL / _FURINI)
+        ctypes.c_int,                        # temps_max
+        ctypes.c_int,                        # prove
+        ctypes.c_void_p,                     # ProgressRing*
+        ctypes.POINTER(ctypes.c_int),        # cancel token (or NULL)
+        ctypes.POINTER(ctypes.c_int),        # out_K
+        ctypes.POINTER(ctypes.c_int),        # out_coloring[dyn_vertices]
+        ctypes.POINTER(ctypes.c_int),        # out_LB
+        ctypes.POINTER(ctypes.c_int),        # out_optimal
+        ctypes.POINTER(ctypes.c_long),       # out_nodes
+        ctypes.POINTER(ctypes.c_long),       # out_cuts
+        ctypes.POINTER(ctypes.c_double),     # out_time
+        ctypes.POINTER(ctypes.c_int),        # out_timeout
+        ctypes.POINTER(ctypes.c_int),        # out_cancelled
+        ctypes.POINTER(ctypes.c_int),        # out_searched
+    ]
+
+    lib.bb_graph_fingerprint.restype  = ctypes.c_uint64
+    lib.bb_graph_fingerprint.argtypes = [
+        ctypes.c_int,
+        ctypes.POINTER(ctypes.c_int),        # adj
+        ctypes.POINTER(ctypes.c_int),        # start
+        ctypes.POINTER(ctypes.c_int),        # deg
+    ]
+
+    # ── Native DIMACS loader (loader.c) ────────────────────────────────
+    lib.dimacs_scan.restype  = ctypes.c_int
+    lib.dimacs_scan.argtypes = [
+        ctypes.c_void_p, ctypes.c_long,      # buf, len
+        ctypes.POINTER(ctypes.c_int),        # out_n
+        ctypes.POINTER(ctypes.c_long),       # out_edges (e-lines)
+    ]
+    lib.dimacs_csr.restype  = ctypes.c_long  # adjacency entries used
+    lib.dimacs_csr.argtypes = [
+        ctypes.c_void_p, ctypes.c_long,      # buf, len
+        ctypes.c_int, ctypes.c_long,         # n, edges
+        ctypes.POINTER(ctypes.c_int),        # adj[2·edges]
+        ctypes.POINTER(ctypes.c_int),        # start[n]
+        ctypes.POINTER(ctypes.c_int),        # deg[n]
+    ]
+    lib.csr_check.restype  = ctypes.c_int
+    lib.csr_check.argtypes = [
+        ctypes.c_int, ctypes.c_long,         # n, entries
+        ctypes.POINTER(ctypes.c_int),        # adj
+        ctypes.POINTER(ctypes.c_int),        # start
+        ctypes.POINTER(ctypes.c_int),        # deg
+    ]
+
     return lib
 
 
 _lib: ctypes.CDLL | None = None
-_CB_TYPE = None
+
+
+class _ProgressRec(ctypes.Structure):
+    """ProgressRec in coloring.h."""
+    _fields_ = [
+        ("seq",   ctypes.c_uint64),
+        ("nodes", ctypes.c_long),
+        ("cuts",  ctypes.c_long),
+        ("t",     ctypes.c_double),
+        ("UB",    ctypes.c_int),
+        ("LB",    ctypes.c_int),
+        ("depth", ctypes.c_int),
+        ("pad_",  ctypes.c_int),
+    ]
+
+
+# BB_PH_* / BB_STATS_* in coloring.h
+_STAT_PHASES = ("select", "bound", "color", "uncolor", "clock")
+_STAT_DEPTHS = 256
+_STAT_BRANCH = 64
+
+
+class _BBStats(ctypes.Structure):
+    """BBStats in coloring.h."""
+    _fields_ = [
+        ("cycles",      ctypes.c_uint64 * len(_STAT_PHASES)),
+        ("calls",       ctypes.c_uint64 * len(_STAT_PHASES)),
+        ("max_depth",   ctypes.c_uint64),
+        ("depth_nodes", ctypes.c_uint64 * _STAT_DEPTHS),
+        ("depth_tests", ctypes.c_uint64 * _STAT_DEPTHS),
+        ("depth_cuts",  ctypes.c_uint64 * _STAT_DEPTHS),
+        ("branching",   ctypes.c_uint64 * _STAT_BRANCH),
+    ]
+
+
+def _stats_dict(st: _BBStats) -> dict:
+    """
+    res["stats"]: "cycles" / "appels" per phase; "par_profondeur" one row
+    per depth up to the deepest node (the last slot also counts deeper
+    nodes), with tested / pruned inner nodes; "branchement"[b] = number
+    of branching nodes that took b branches (trailing zeros dropped).
+    """
+    depth = min(st.max_depth, _STAT_DEPTHS - 1)
+    branch = list(st.branching)
+    while branch and branch[-1] == 0:
+        branch.pop()
+    return {
+        "cycles":         dict(zip(_STAT_PHASES, st.cycles)),
+        "appels":         dict(zip(_STAT_PHASES, st.calls)),
+        "profondeur_max": st.max_depth,
+        "par_profondeur": [{"profondeur": d, "noeuds": st.depth_nodes[d],
+                            "tests": st.depth_tests[d], "coupes": st.depth_cuts[d]}
+                           for d in range(depth + 1)],
+        "branchement":    branch,
+    }
+
+
+class _BatchResult(ctypes.Structure):
+    """BatchResult in batch.h."""
+    _fields_ = [
+        ("nodes",     ctypes.c_long),
+        ("cuts",      ctypes.c_long),
+        ("time",      ctypes.c_double),
+        ("K",         ctypes.c_int),
+        ("LB",        ctypes.c_int),
+        ("UB_init",   ctypes.c_int),
+        ("optimal",   ctypes.c_int),
+        ("timeout",   ctypes.c_int),
+        ("cancelled", ctypes.c_int),
+        ("backend",   ctypes.c_int),
+    ]
+
+
+_PROGRESS_RING_CAP = 4096    # PROGRESS_RING_CAP in coloring.h
+_POLL_S            = 0.1     # progress ring polling period (s)
+
+# Adjacency backend codes (ADJ_CSR / ADJ_BITSET in coloring.h)
+_BACKENDS = {0: "csr", 1: "bitset"}
+
+# BB_MAX_COLORS / BB_ERR_COLORS in coloring.h: the B&B cannot start from
+# an incumbent with more colours than its 16-bit search records hold
+_BB_MAX_COLORS = 32767
+_BB_ERR_COLORS = -1
+
+
+def _colors_error(what: str) -> ValueError:
+    return ValueError(f"{what}: the start-up colouring needs more than {_BB_MAX_COLORS} "
+                      "colours (BB_MAX_COLORS), the most the B&B can search with")
 
 
 def get_lib() -> ctypes.CDLL:
@@ -139,43 +457,138 @@ def get_lib() -> ctypes.CDLL:
 
 # ── CSR conversion ────────────────────────────────────────────────────────
 
+# Buffer formats that are laid out exactly like a C int
+_C_INT_FORMATS = {"i", "@i", "=i"} | (
+    {"l", "@l", "=l"} if ctypes.sizeof(ctypes.c_long) == ctypes.sizeof(ctypes.c_int)
+    else set())
+
+
+def _as_c_int(seq, length: int):
+    """
+    int[length] ctypes view of seq. A writable, C-contiguous buffer of C
+    ints (numpy.int32, array('i'), …) is shared as-is; a read-only one
+    is copied with one memcpy; anything else (lists) is packed through
+    array('i') in a single C-level pass.
+    """
+    ctype = ctypes.c_int * length
+    try:
+        mv = memoryview(seq)
+    except TypeError:
+        mv = None
+    if (mv is not None and mv.ndim == 1 and mv.c_contiguous
+            and mv.format in _C_INT_FORMATS and len(mv) == length):
+        return ctype.from_buffer_copy(mv) if mv.readonly else ctype.from_buffer(mv)
+    return ctype.from_buffer(array.array("i", seq))
+
+
 def _to_csr(graph_data: dict):
     n        = graph_data["n"]
     adj_flat = graph_data["adj_flat"]
-    start    = graph_data["start"]
-    deg      = graph_data["deg"]
     m        = len(adj_flat)
 
-    c_adj   = (ctypes.c_int * m)(*adj_flat)
-    c_start = (ctypes.c_int * n)(*start)
-    c_deg   = (ctypes.c_int * n)(*deg)
+    c_adj   = _as_c_int(adj_flat, m)
+    c_start = _as_c_int(graph_data["start"], n)
+    c_deg   = _as_c_int(graph_data["deg"], n)
     return c_adj, c_start, c_deg
 
 
-# ── Callback factory ──────────────────────────────────────────────────────
+def _coloring_out(c_coloring):
+    """The solver's colouring buffer as a numpy view (no copy) when available."""
+    if _np is not None:
+        return _np.frombuffer(c_coloring, dtype=_np.intc)
+    return list(c_coloring)
+
+
+# ── Progress poller ───────────────────────────────────────────────────────
+
+class _Progress:
+    """
+    Owns a C progress ring while a solve runs. A daemon thread drains it
+    every _POLL_S seconds into historique (one snapshot per record) and
+    the newest record into live; stop() drains what is left and, in a
+    BB_STATS build, reads the solve's statistics into self.stats.
+    """
+
+    def __init__(self, lib: ctypes.CDLL, historique: list, live: dict | None):
+        self.lib, self.historique, self.live = lib, historique, live
+        self.ring = lib.progress_ring_new()
+        if not self.ring:
+            raise MemoryError("progress_ring_new failed")
+        self.stats: dict | None = None
+        self.cursor = ctypes.c_uint64(0)
+        self.buf = (_ProgressRec * _PROGRESS_RING_CAP)()
+        self.done = threading.Event()
+        self.thread = threading.Thread(target=self._run, daemon=True)
+        self.thread.start()
+
+    def _drain(self):
+        got = self.lib.progress_ring_read(self.ring, ctypes.byref(self.cursor),
+                                          self.buf, _PROGRESS_RING_CAP)
+        for r in self.buf[:got]:
+            self.historique.append({"noeuds": r.nodes, "UB": r.UB, "LB": r.LB,
+                                    "temps": r.t, "coupes": r.cuts,
+                                    "profondeur": r.depth, "done": False})
+        if got and self.live is not None:
+            self.live.update(self.historique[-1])
+
+    def _run(self):
+        while not self.done.wait(_POLL_S):
+            self._drain()
 
-def _make_cb(historique: list, live: dict | None):
-    def _inner(nodes, UB, LB, t, cuts):
-        snap = {"noeuds": nodes, "UB": UB, "LB": LB,
-                "temps": t, "coupes": cuts, "done": False}
-        historique.append(snap)
-        if live is not None:
-            live.update(snap)
-    return _CB_TYPE(_inner)
+    def stop(self):
+        self.done.set()
+        self.thread.join()
+        self._drain()
+        st = _BBStats()
+        if self.lib.progress_ring_stats(self.ring, ctypes.byref(st)):
+            self.stats = _stats_dict(st)
+        self.lib.progress_ring_free(self.ring)
+        self.ring = None
+
+
+# ── Cancellation ──────────────────────────────────────────────────────────
+
+class CancelToken:
+    """
+    Stop flag for one solve (the C cancel token, coloring.h): pass it as
+    cancel_token= to a solve_* function or DynamicGraph.solve(), then
+    cancel(token) from any thread. Other solves are not affected. A token
+    stays cancelled, so each solve needs a fresh one.
+    """
+
+    def __init__(self):
+        self.flag = ctypes.c_int(0)
+
+    @property
+    def cancelled(self) -> bool:
+        return bool(self.flag.value)
+
+
+def _token_ref(token: CancelToken | None):
+    return ctypes.byref(token.flag) if token is not None else None
+
+
+def cancel(token: CancelToken) -> None:
+    """
+    Stop the solve(s) given this token, from any thread. Each returns its
+    best result so far as a timeout with res["cancelled"] True; resumable
+    runs still write their checkpoint.
+    """
+    get_lib().bb_cancel(ctypes.byref(token.flag))
 
 
 # ── Generic solver wrapper ────────────────────────────────────────────────
 
 def _solve(c_func_name: str, algo_name: str,
            graph_data: dict, temps_max: int,
-           live_state: dict | None) -> dict:
+           live_state: dict | None, *extra_args,
+           cancel_token: CancelToken | None = None) -> dict:
 
     lib = get_lib()
     n   = graph_data["n"]
 
     c_adj, c_start, c_deg = _to_csr(graph_data)
     historique: list = []
-    cb = _make_cb(historique, live_state)
 
     c_coloring = (ctypes.c_int * n)()
     out_K      = ctypes.c_int()
@@ -186,25 +599,36 @@ def _solve(c_func_name: str, algo_name: str,
     out_cuts   = ctypes.c_long()
     out_time   = ctypes.c_double()
     out_tout   = ctypes.c_int()
+    out_canc   = ctypes.c_int()
+    out_back   = ctypes.c_int()
 
     func = getattr(lib, c_func_name)
-    func(
-        ctypes.c_int(n), c_adj, c_start, c_deg,
-        ctypes.c_int(temps_max), cb,
-        ctypes.byref(out_K), c_coloring,
-        ctypes.byref(out_LB), ctypes.byref(out_UBi),
-        ctypes.byref(out_opt), ctypes.byref(out_nodes),
-        ctypes.byref(out_cuts), ctypes.byref(out_time),
-        ctypes.byref(out_tout),
-    )
+    progress = _Progress(lib, historique, live_state)
+    try:
+        status = func(
+            ctypes.c_int(n), c_adj, c_start, c_deg,
+            ctypes.c_int(temps_max), progress.ring, _token_ref(cancel_token),
+            ctypes.byref(out_K), c_coloring,
+            ctypes.byref(out_LB), ctypes.byref(out_UBi),
+            ctypes.byref(out_opt), ctypes.byref(out_nodes),
+            ctypes.byref(out_cuts), ctypes.byref(out_time),
+            ctypes.byref(out_tout), ctypes.byref(out_canc), ctypes.byref(out_back),
+            *extra_args,
+        )
+    finally:
+        progress.stop()
+    if status == 0:   # *_resume: input rejected
+        raise ValueError(f"{c_func_name}: invalid checkpoint for this graph")
+    if status == _BB_ERR_COLORS:
+        raise _colors_error(c_func_name)
 
     if live_state is not None:
         live_state.update({"done": True})
 
-    return {
+    res = {
         "algo":            algo_name,
         "K":               out_K.value,
-        "coloriage":       list(c_coloring),
+        "coloriage":       _coloring_out(c_coloring),
         "LB":              out_LB.value,
         "UB_init":         out_UBi.value,
         "optimal":         bool(out_opt.value),
@@ -212,24 +636,421 @@ def _solve(c_func_name: str, algo_name: str,
         "coupes":          out_cuts.value,
         "temps":           out_time.value,
         "timeout":         bool(out_tout.value),
+        "cancelled":       bool(out_canc.value),
+        "backend":         _BACKENDS.get(out_back.value, "csr"),
         "historique_kpi":  historique,
     }
+    if progress.stats is not None:
+        res["stats"] = progress.stats
+    return res
 
 
 # ── Public API ────────────────────────────────────────────────────────────
 
 def solve_sewell(graph_data: dict, temps_max: int,
-                 live_state: dict | None = None) -> dict:
+                 live_state: dict | None = None,
+                 cancel_token: CancelToken | None = None) -> dict:
     """Run Sewell (1996) B&B. Returns result dict."""
     return _solve("sewell_solve", "Sewell (1996)",
-                  graph_data, temps_max, live_state)
+                  graph_data, temps_max, live_state, cancel_token=cancel_token)
 
 
 def solve_furini(graph_data: dict, temps_max: int,
-                 live_state: dict | None = None) -> dict:
+                 live_state: dict | None = None,
+                 cancel_token: CancelToken | None = None) -> dict:
     """Run Furini (2017) B&B. Returns result dict."""
     return _solve("furini_solve", "Furini (2017)",
-                  graph_data, temps_max, live_state)
+                  graph_data, temps_max, live_state, cancel_token=cancel_token)
+
+
+def set_presolve_share(share: float) -> None:
+    """Fraction of temps_max spent in the clique / TabuCol pre-solve (default 0.05)."""
+    get_lib().bb_set_presolve_share(ctypes.c_double(share))
+
+
+def set_clique_share(share: float) -> None:
+    """Fraction of temps_max given to the exact root clique search (default 0.05)."""
+    get_lib().bb_set_clique_share(ctypes.c_double(share))
+
+
+def set_reduce(on: bool) -> None:
+    """Kernelize graphs (low-degree / dominated vertices) and split them into
+    biconnected blocks before the B&B (default on)."""
+    get_lib().bb_set_reduce(ctypes.c_int(1 if on else 0))
+
+
+# relabel.h RELABEL_* codes
+RELABEL_MODES = {"none": 0, "degeneracy": 1, "rcm": 2, "bfs": 3}
+
+
+def set_relabel(mode: str) -> None:
+    """Renumber vertices for cache locality before the B&B: one of
+    RELABEL_MODES (default "none"). Colourings come back in the input order."""
+    if mode not in RELABEL_MODES:
+        raise ValueError(f"unknown relabel mode {mode!r} (one of {', '.join(RELABEL_MODES)})")
+    get_lib().bb_set_relabel(ctypes.c_int(RELABEL_MODES[mode]))
+
+
+def set_frac_lb(depth: int, share: float | None = None) -> None:
+    """Fractional chromatic (column-generation LP) lower bound for later
+    solves: depth < 0 off (default), 0 at the root, d > 0 also at Furini
+    nodes of depth ≤ d. share: fraction of temps_max it may spend at the
+    root, and again per search thread on nodes (default 0.05)."""
+    lib = get_lib()
+    lib.bb_set_frac_depth(ctypes.c_int(depth))
+    if share is not None:
+        lib.bb_set_frac_share(ctypes.c_double(share))
+
+
+def max_clique(graph_data: dict, time_limit: float = 0.0,
+               cancel_token: CancelToken | None = None) -> tuple[int, bool]:
+    """
+    Bit-parallel exact maximum clique (C max_clique()).
+    Returns (size, exact); exact is False when time_limit ran out (or the
+    token was cancelled) first.
+    """
+    n = graph_data["n"]
+    c_adj, c_start, c_deg = _to_csr(graph_data)
+    exact = ctypes.c_int(0)
+    size = get_lib().max_clique(n, c_adj, c_start, c_deg, 0, n,
+                                ctypes.c_double(time_limit), _token_ref(cancel_token),
+                                ctypes.byref(exact))
+    return size, bool(exact.value)
+
+
+def _default_threads(n_threads: int | None) -> int:
+    return max(1, n_threads if n_threads else (os.cpu_count() or 1))
+
+
+def solve_sewell_parallel(graph_data: dict, temps_max: int,
+                          n_threads: int | None = None,
+                          live_state: dict | None = None,
+                          cancel_token: CancelToken | None = None) -> dict:
+    """Run Sewell B&B on n_threads work-stealing workers (default: all cores)."""
+    n_threads = _default_threads(n_threads)
+    res = _solve("sewell_solve_parallel", "Sewell (1996)",
+                 graph_data, temps_max, live_state, ctypes.c_int(n_threads),
+                 cancel_token=cancel_token)
+    res["threads"] = n_threads
+    return res
+
+
+def solve_furini_parallel(graph_data: dict, temps_max: int,
+                          n_threads: int | None = None,
+                          live_state: dict | None = None,
+                          cancel_token: CancelToken | None = None) -> dict:
+    """Run Furini B&B on n_threads work-stealing workers (default: all cores)."""
+    n_threads = _default_threads(n_threads)
+    res = _solve("furini_solve_parallel", "Furini (2017)",
+                 graph_data, temps_max, live_state, ctypes.c_int(n_threads),
+                 cancel_token=cancel_token)
+    res["threads"] = n_threads
+    return res
+
+
+def portfolio_member_name(i: int) -> str:
+    """Strategy run by portfolio member i (see logic/portfolio.c)."""
+    engine = "Sewell" if i % 2 == 0 else "Furini"
+    return engine if i < 2 else f"{engine} (seed {i // 2})"
+
+
+def solve_portfolio(graph_data: dict, temps_max: int,
+                    n_threads: int | None = None,
+                    live_state: dict | None = None,
+                    cancel_token: CancelToken | None = None) -> dict:
+    """
+    Run Sewell, Furini and reseeded variants cooperatively on n_threads
+    threads (default: all cores, at least 2) with one shared incumbent.
+    Stops as soon as any member proves optimality.
+    """
+    n_threads = max(2, _default_threads(n_threads))
+    out_win = ctypes.c_int(-1)
+    res = _solve("portfolio_solve", "Portfolio",
+                 graph_data, temps_max, live_state,
+                 ctypes.c_int(n_threads), ctypes.byref(out_win),
+                 cancel_token=cancel_token)
+    res["threads"] = n_threads
+    res["winner"]  = (portfolio_member_name(out_win.value)
+                      if out_win.value >= 0 else None)
+    return res
+
+
+def graph_fingerprint(graph_data: dict) -> str:
+    """Hex content hash of the graph's CSR (C graph_fingerprint())."""
+    c_adj, c_start, c_deg = _to_csr(graph_data)
+    fp = get_lib().bb_graph_fingerprint(graph_data["n"], c_adj, c_start, c_deg)
+    return f"{fp:016x}"
+
+
+def solve_warm(algo: str, graph_data: dict, temps_max: int,
+               warm_coloring=None, known_LB: int = 0,
+               live_state: dict | None = None,
+               cancel_token: CancelToken | None = None) -> dict:
+    """
+    Sequential Sewell / Furini run seeded with a known incumbent
+    colouring (used instead of DSATUR if valid) and a proven lower
+    bound. Returns immediately when known_LB meets the incumbent.
+    """
+    c_name = {"sewell": "sewell_solve_warm", "furini": "furini_solve_warm"}[algo]
+    algo_name = _RESUMABLE[algo][1]
+    n = graph_data["n"]
+    warm_UB, c_warm = 0, None
+    if warm_coloring is not None and len(warm_coloring) == n and n > 0:
+        c_warm  = _as_c_int(warm_coloring, n)
+        warm_UB = max(int(c) for c in warm_coloring) + 1
+    return _solve(c_name, algo_name, graph_data, temps_max, live_state,
+                  ctypes.c_int(warm_UB), c_warm, ctypes.c_int(known_LB),
+                  cancel_token=cancel_token)
+
+
+# BB_BACKJUMP / BB_NOGOODS in backjump.h
+_BB_BACKJUMP, _BB_NOGOODS = 1, 2
+
+
+def solve_backjump(algo: str, graph_data: dict, temps_max: int,
+                   nogoods: bool = True,
+                   live_state: dict | None = None,
+                   cancel_token: CancelToken | None = None) -> dict:
+    """
+    Sequential Sewell / Furini run with conflict-directed backjumping:
+    a vertex out of colours sends the search straight back to the
+    deepest assignment its dead end depends on. With nogoods, short dead
+    ends are also recorded and cut when they come back.
+    res["sauts"]: frames skipped by backjumps; res["coupes_nogood"]:
+    branches cut by nogoods (both included in res["coupes"]).
+    """
+    c_name = {"sewell": "sewell_solve_backjump", "furini": "furini_solve_backjump"}[algo]
+    algo_name = _RESUMABLE[algo][1]
+    mode = _BB_BACKJUMP | (_BB_NOGOODS if nogoods else 0)
+    out_jumps = ctypes.c_long(0)
+    out_ng    = ctypes.c_long(0)
+    res = _solve(c_name, algo_name, graph_data, temps_max, live_state,
+                 ctypes.c_int(mode), ctypes.byref(out_jumps), ctypes.byref(out_ng),
+                 cancel_token=cancel_token)
+    res["sauts"]         = out_jumps.value
+    res["coupes_nogood"] = out_ng.value
+    return res
+
+
+_RESUMABLE = {
+    "sewell": ("sewell_resume", "Sewell (1996)"),
+    "furini": ("furini_resume", "Furini (2017)"),
+}
+
+
+def solve_resumable(algo: str, graph_data: dict, temps_max: int,
+                    checkpoint: bytes | None = None,
+                    live_state: dict | None = None,
+                    cancel_token: CancelToken | None = None) -> dict:
+    """
+    Sequential Sewell / Furini run that can be continued later.
+
+    If the time limit fires, res["checkpoint"] holds the search frontier,
+    incumbent, LB and counters as bytes (else None). Pass it back as
+    `checkpoint` on the same graph to resume with a fresh temps_max;
+    nodes, cuts and time then accumulate across runs. Raises ValueError
+    if the checkpoint belongs to another graph or algorithm.
+    """
+    c_name, algo_name = _RESUMABLE[algo]
+    n = graph_data["n"]
+    out_ckpt = (ctypes.c_ubyte * get_lib().bb_checkpoint_bytes(n))()
+    out_len  = ctypes.c_int(0)
+    res = _solve(c_name, algo_name, graph_data, temps_max, live_state,
+                 checkpoint, len(checkpoint) if checkpoint else 0,
+                 out_ckpt, ctypes.byref(out_len), cancel_token=cancel_token)
+    res["checkpoint"] = bytes(out_ckpt[:out_len.value]) if out_len.value else None
+    res["resumed"]    = checkpoint is not None
+    return res
+
+
+# BATCH_* codes in batch.h, DYN_* in dynamic.h
+_ENGINE_CODES = {"sewell": 0, "furini": 1}
+
+
+def _extend_c_ints(buf: array.array, seq) -> None:
+    """Append seq to an array('i'): one memcpy for C-int buffers, else item by item."""
+    try:
+        mv = memoryview(seq)
+    except TypeError:
+        mv = None
+    if mv is not None and mv.ndim == 1 and mv.c_contiguous and mv.format in _C_INT_FORMATS:
+        buf.frombytes(mv.cast("B"))
+    else:
+        buf.extend(seq)
+
+
+def solve_batch(graphs, algo: str, temps_max: int,
+                n_threads: int | None = None,
+                cancel_token: CancelToken | None = None) -> list[dict]:
+    """
+    Sequential Sewell / Furini runs on many graphs in one C call: a pool
+    of n_threads threads (default: all cores) takes them largest first,
+    each with the full temps_max. Returns one result dict per graph, in
+    input order, with the keys of solve_sewell() (no progress history).
+    The inputs go to C packed in one buffer, and the colourings come
+    back in one buffer; without numpy each colouring is a list copy.
+    """
+    if algo not in _ENGINE_CODES:
+        raise ValueError(f"unknown batch algo {algo!r} (one of {', '.join(_ENGINE_CODES)})")
+    lib = get_lib()
+    graphs = list(graphs)
+    if not graphs:
+        return []
+    packed = array.array("i")
+    for gd in graphs:
+        packed.append(gd["n"])
+        packed.append(len(gd["adj_flat"]))
+        _extend_c_ints(packed, gd["start"])
+        _extend_c_ints(packed, gd["deg"])
+        _extend_c_ints(packed, gd["adj_flat"])
+    total_n = sum(gd["n"] for gd in graphs)
+
+    c_buf  = (ctypes.c_int * len(packed)).from_buffer(packed)
+    c_out  = (_BatchResult * len(graphs))()
+    c_cols = (ctypes.c_int * max(1, total_n))()
+    ok = lib.batch_solve(_ENGINE_CODES[algo], c_buf, len(packed), len(graphs),
+                         temps_max, _default_threads(n_threads), _token_ref(cancel_token),
+                         c_out, c_cols)
+    if not ok:
+        raise ValueError("batch_solve: malformed graph (unsorted or out-of-range CSR) or out of memory")
+    if ok == _BB_ERR_COLORS:
+        raise _colors_error("batch_solve")
+
+    algo_name = _RESUMABLE[algo][1]
+    cols = _coloring_out(c_cols)
+    results, off = [], 0
+    for gd, r in zip(graphs, c_out):
+        n = gd["n"]
+        results.append({
+            "algo":            algo_name,
+            "K":               r.K,
+            "coloriage":       cols[off:off + n],
+            "LB":              r.LB,
+            "UB_init":         r.UB_init,
+            "optimal":         bool(r.optimal),
+            "noeuds":          r.nodes,
+            "coupes":          r.cuts,
+            "temps":           r.time,
+            "timeout":         bool(r.timeout),
+            "cancelled":       bool(r.cancelled),
+            "backend":         _BACKENDS.get(r.backend, "csr"),
+            "historique_kpi":  [],
+        })
+        off += n
+    return results
+
+
+class DynamicGraph:
+    """
+    A graph that changes between solves (C DynGraph, dynamic.h).
+
+    Vertex ids are stable: remove_vertex() leaves a dead id, add_vertex()
+    returns the next one. solve() repairs the last colouring locally and
+    only runs the B&B (warm-started from it) when the repair needs a new
+    colour, or when prove=True and K > LB; res["recherche"] tells which.
+    Dead vertices get colour -1 in res["coloriage"]. The update methods
+    return True when the graph changed, and raise ValueError on an
+    unknown vertex id.
+    """
+
+    def __init__(self, graph_data: dict | None = None):
+        self._h = None
+        self._lib = get_lib()
+        if graph_data is None:
+            graph_data = {"n": 0, "adj_flat": [], "start": [], "deg": []}
+        c_adj, c_start, c_deg = _to_csr(graph_data)
+        self._h = self._lib.dyn_new(graph_data["n"], c_adj, c_start, c_deg)
+        if not self._h:
+            raise MemoryError("dyn_new failed")
+
+    def _check(self, status: int, what: str) -> bool:
+        if status < 0:
+            raise ValueError(f"DynamicGraph.{what}: unknown vertex id (or out of memory)")
+        return bool(status)
+
+    @property
+    def n(self) -> int:
+        """Vertex ids handed out so far, dead ones included."""
+        return self._lib.dyn_vertices(self._h)
+
+    def add_edge(self, u: int, v: int) -> bool:
+        return self._check(self._lib.dyn_add_edge(self._h, u, v), "add_edge")
+
+    def remove_edge(self, u: int, v: int) -> bool:
+        return self._check(self._lib.dyn_remove_edge(self._h, u, v), "remove_edge")
+
+    def add_vertex(self) -> int:
+        v = self._lib.dyn_add_vertex(self._h)
+        if v < 0:
+            raise MemoryError("dyn_add_vertex failed")
+        return v
+
+    def remove_vertex(self, v: int) -> bool:
+        return self._check(self._lib.dyn_remove_vertex(self._h, v), "remove_vertex")
+
+    def seed(self, coloring, LB: int = 0) -> None:
+        """Adopt a proper colouring of the current graph and a proven LB."""
+        n = self.n
+        if len(coloring) != n or not self._lib.dyn_seed(self._h, _as_c_int(coloring, n), LB):
+            raise ValueError("DynamicGraph.seed: not a proper colouring of the current graph")
+
+    def solve(self, algo: str = "furini", temps_max: int = 60, prove: bool = False,
+              live_state: dict | None = None,
+              cancel_token: CancelToken | None = None) -> dict:
+        if algo not in _ENGINE_CODES:
+            raise ValueError(f"unknown algo {algo!r} (one of {', '.join(_ENGINE_CODES)})")
+        lib = self._lib
+        historique: list = []
+        c_coloring = (ctypes.c_int * max(1, self.n))()
+        out_K, out_LB, out_opt = ctypes.c_int(), ctypes.c_int(), ctypes.c_int()
+        out_nodes, out_cuts    = ctypes.c_long(), ctypes.c_long()
+        out_time               = ctypes.c_double()
+        out_tout, out_search   = ctypes.c_int(), ctypes.c_int()
+        out_canc               = ctypes.c_int()
+
+        progress = _Progress(lib, historique, live_state)
+        try:
+            ok = lib.dyn_solve(self._h, _ENGINE_CODES[algo], temps_max, int(prove),
+                               progress.ring, _token_ref(cancel_token),
+                               ctypes.byref(out_K), c_coloring,
+                               ctypes.byref(out_LB), ctypes.byref(out_opt),
+                               ctypes.byref(out_nodes), ctypes.byref(out_cuts),
+                               ctypes.byref(out_time), ctypes.byref(out_tout),
+                               ctypes.byref(out_canc), ctypes.byref(out_search))
+        finally:
+            progress.stop()
+        if not ok:
+            raise MemoryError("dyn_solve failed")
+        if ok == _BB_ERR_COLORS:
+            raise _colors_error("dyn_solve")
+        if live_state is not None:
+            live_state.update({"done": True})
+
+        res = {
+            "algo":            _RESUMABLE[algo][1],
+            "K":               out_K.value,
+            "coloriage":       _coloring_out(c_coloring)[:self.n],
+            "LB":              out_LB.value,
+            "optimal":         bool(out_opt.value),
+            "noeuds":          out_nodes.value,
+            "coupes":          out_cuts.value,
+            "temps":           out_time.value,
+            "timeout":         bool(out_tout.value),
+            "cancelled":       bool(out_canc.value),
+            "recherche":       bool(out_search.value),
+            "historique_kpi":  historique,
+        }
+        if progress.stats is not None:
+            res["stats"] = progress.stats
+        return res
+
+    def close(self) -> None:
+        if self._h:
+            self._lib.dyn_free(self._h)
+            self._h = None
+
+    def __del__(self):
+        self.close()
 
 
 # ── Pre-warm: compile on import ───────────────────────────────────────────
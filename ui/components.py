@@ -93,6 +93,6 @@ def winner_banner(msg: str) -> str:
 
 
 def algo_header(name: str, variant: str) -> str:
-    """variant: 's' for Sewell (blue) or 'f' for Furini (green)."""
-    cls = "algo-header-s" if variant == "s" else "algo-header-f"
+    """variant: 's' for Sewell (blue), 'f' for Furini (green) or 'p' for Portfolio (amber)."""
+    cls = f"algo-header-{variant}"
     return f'<div class="{cls}">◉  {name}</div>'
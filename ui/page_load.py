@@ -5,7 +5,7 @@ Step 1: upload a DIMACS .col file, preview the graph, show initial bounds.
 """
 
 import streamlit as st
-from logic.graph import parse_dimacs
+from logic.graph import parse_dimacs, parse_csr
 from ui.components import step_pill, stat_grid, divider
 from ui.plots import build_graph_pos, fig_plain_graph
 
@@ -17,8 +17,8 @@ def render():
 
     with left:
         uploaded = st.file_uploader(
-            "Drop a DIMACS .col file here",
-            type="col", label_visibility="collapsed",
+            "Drop a DIMACS .col (or binary .csr) file here",
+            type=["col", "csr"], label_visibility="collapsed",
         )
 
 
@@ -29,7 +29,9 @@ def render():
 
     try:
         with st.spinner("Parsing DIMACS…"):
-            gd = parse_dimacs(uploaded.read())
+            raw = uploaded.read()
+            gd = (parse_csr(raw) if uploaded.name.lower().endswith(".csr")
+                  else parse_dimacs(raw))
     except Exception as exc:
         st.error(f"Parse error: {exc}")
         return
@@ -57,6 +59,7 @@ def render():
     st.session_state.graph_pos      = (G, pos)
     st.session_state.res_sewell     = None
     st.session_state.res_furini     = None
+    st.session_state.res_portfolio  = None
 
     if st.button("Run Algorithms →", use_container_width=True):
         st.session_state.page = "run"
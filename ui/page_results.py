@@ -14,6 +14,7 @@ from ui.plots import (
     fig_colored_graph, fig_progress,
     fig_color_distribution, fig_ub_convergence,
     fig_bar_compare,
+    fig_phase_cycles, fig_depth_pruning, fig_branching,
 )
 
 
@@ -50,6 +51,28 @@ def _render_algo_tab(tab, res: dict, variant: str, line_color: str, key_prefix:
             st.plotly_chart(fig_color_distribution(res),
                             use_container_width=True, key=f"{key_prefix}_dist")
 
+        # Search instrumentation (library built with COLORING_STATS=1)
+        stats = res.get("stats")
+        if stats:
+            with st.expander(f"Search Instrumentation — max depth {stats['profondeur_max']}",
+                             expanded=False):
+                st.markdown("**Cycles per Phase**")
+                st.plotly_chart(fig_phase_cycles(stats, line_color),
+                                use_container_width=True, key=f"{key_prefix}_phases")
+                d_col, b_col = st.columns(2)
+                with d_col:
+                    st.markdown("**Nodes and Pruning by Depth**")
+                    fig_d = fig_depth_pruning(stats, line_color)
+                    if fig_d:
+                        st.plotly_chart(fig_d, use_container_width=True,
+                                        key=f"{key_prefix}_depth")
+                with b_col:
+                    st.markdown("**Branching Factor**")
+                    fig_b = fig_branching(stats, line_color)
+                    if fig_b:
+                        st.plotly_chart(fig_b, use_container_width=True,
+                                        key=f"{key_prefix}_branch")
+
         # Colored graph
         st.markdown(divider(), unsafe_allow_html=True)
         st.markdown("**Optimal Graph Coloring**")
@@ -76,6 +99,11 @@ def _render_algo_tab(tab, res: dict, variant: str, line_color: str, key_prefix:
             f"Nodes explored  : {res['noeuds']:,}",
             f"Branches pruned : {res['coupes']:,}",
             f"Timeout         : {res['timeout']}",
+            f"Stopped by user : {res.get('cancelled', False)}",
+            f"Adjacency       : {res.get('backend', 'csr')}",
+        ] + ([
+            f"Proved by       : {res.get('winner') or '—'}",
+        ] if "winner" in res else []) + [
             "", "Coloring (vertex: color):",
         ] + [f"  {i+1}: C{res['coloriage'][i]}" for i in range(gd["n"])]
 
@@ -180,8 +208,9 @@ def render():
     gd = st.session_state.get("graph_data")
     rs = st.session_state.get("res_sewell")
     rf = st.session_state.get("res_furini")
+    rp = st.session_state.get("res_portfolio")
 
-    if gd is None or (rs is None and rf is None):
+    if gd is None or (rs is None and rf is None and rp is None):
         st.session_state.page = "load"
         st.rerun()
 
@@ -204,14 +233,17 @@ def render():
     if rf:
         tab_names.append("Furini (2017)")
         renderers.append(("f", "#38c172", "furini"))
+    if rp:
+        tab_names.append("Portfolio")
+        renderers.append(("p", "#e2a84a", "portfolio"))
     if rs and rf:
         tab_names.append("Comparison")
 
     tabs = st.tabs(tab_names)
 
+    by_prefix = {"sewell": rs, "furini": rf, "portfolio": rp}
     for i, (variant, color, prefix) in enumerate(renderers):
-        res = rs if variant == "s" else rf
-        _render_algo_tab(tabs[i], res, variant, color, prefix, G, pos, gd)
+        _render_algo_tab(tabs[i], by_prefix[prefix], variant, color, prefix, G, pos, gd)
 
     if rs and rf:
         _render_comparison_tab(tabs[-1], rs, rf, G, pos)
@@ -3,12 +3,18 @@ ui/page_run.py
 ──────────────
 Step 2: live dual-execution racing view.
 Both algorithms run in parallel threads (ctypes releases the GIL).
+Portfolio mode runs them cooperatively inside one native call, sharing
+the incumbent colouring and the lower bound. A running solve is kept in
+session_state (run_job) with its own cancel token; the Stop button
+cancels that token through logic.solver.cancel() and the best results
+so far are shown.
 """
 
 import time
 import threading
 import streamlit as st
-from logic.solver import solve_sewell, solve_furini
+from logic.solver import solve_sewell, solve_furini, solve_portfolio, cancel, CancelToken
+from logic.cache import solve_cached
 from ui.components import (
     step_pill, divider,
     race_panel, race_panel_idle,
@@ -16,6 +22,38 @@ from ui.components import (
 )
 
 
+# Result key → (panel label, colour class, panel side)
+_PANELS = {
+    "res_sewell":    ("SEWELL (1996)",               "race-s", "s"),
+    "res_furini":    ("FURINI (2017)",               "race-f", "f"),
+    "res_portfolio": ("PORTFOLIO (SEWELL + FURINI)", "race-p", "s"),
+}
+
+
+def _start_job(gd: dict, tmax: int, runs: list, status: str, idle: list = ()) -> dict:
+    """
+    Start one daemon thread per (result key, solver fn), all on one
+    cancel token. The job is kept in session_state so a rerun can still
+    watch, stop and collect it. Results of earlier runs are dropped, so
+    the results page only shows this job's engines.
+    """
+    for key in _PANELS:
+        st.session_state.pop(key, None)
+    job = {"live": {}, "res": {}, "threads": [], "status": status, "idle": list(idle),
+           "token": CancelToken()}
+    for key, fn in runs:
+        live = job["live"][key] = {}
+
+        def _t(key=key, fn=fn, live=live):
+            job["res"][key] = fn(gd, tmax, live_state=live, cancel_token=job["token"])
+
+        job["threads"].append(threading.Thread(target=_t, daemon=True))
+    st.session_state.run_job = job
+    for t in job["threads"]:
+        t.start()
+    return job
+
+
 def render():
     gd = st.session_state.get("graph_data")
     if gd is None:
@@ -25,6 +63,13 @@ def render():
     fname    = st.session_state.get("graph_filename", "graph.col")
     tmax     = st.session_state.get("temps_max", 120)
 
+    # Warm start: both engines seeded from (and feeding) the result cache
+    if st.session_state.get("use_cache"):
+        run_sewell = lambda g, t, **kw: solve_cached("sewell", g, t, **kw)
+        run_furini = lambda g, t, **kw: solve_cached("furini", g, t, **kw)
+    else:
+        run_sewell, run_furini = solve_sewell, solve_furini
+
     st.markdown(step_pill("⬡  STEP 02 — LIVE EXECUTION"), unsafe_allow_html=True)
     st.markdown(f"""
 <div style="font-family:'IBM Plex Mono',monospace;font-size:.8rem;
@@ -36,10 +81,11 @@ def render():
 """, unsafe_allow_html=True)
 
     # ── Action buttons ────────────────────────────────────────────────
-    b1, b2, b3 = st.columns([1, 1, 1.5])
+    b1, b2, b3, b4 = st.columns([1, 1, 1.5, 1.2])
     run_s    = b1.button("▶  Sewell only",   use_container_width=True)
     run_f    = b2.button("▶  Furini only",   use_container_width=True)
     run_both = b3.button("▶  Run Both & Compare ↓", use_container_width=True)
+    run_pf   = b4.button("▶  Portfolio",     use_container_width=True)
 
     st.markdown(divider(), unsafe_allow_html=True)
 
@@ -52,77 +98,64 @@ def render():
     ph_s = col_s.empty()
     ph_f = col_f.empty()
     ph_status = st.empty()
+    ph_stop   = st.empty()
 
     # ── Helpers ───────────────────────────────────────────────────────
-    def _render_panels(live_s, live_f):
-        ph_s.markdown(race_panel("SEWELL (1996)", "race-s", live_s), unsafe_allow_html=True)
-        ph_f.markdown(race_panel("FURINI (2017)", "race-f", live_f), unsafe_allow_html=True)
-
-    def _run_both_parallel():
-        live_s: dict = {}
-        live_f: dict = {}
-
-        res_s = [None]
-        res_f = [None]
-
-        def _ts():
-            res_s[0] = solve_sewell(gd, tmax, live_s)
-
-        def _tf():
-            res_f[0] = solve_furini(gd, tmax, live_f)
-
-        ts = threading.Thread(target=_ts, daemon=True)
-        tf = threading.Thread(target=_tf, daemon=True)
-        ts.start(); tf.start()
-        ph_status.info("⟳  Both algorithms running in parallel (C engine)…")
-
-        while ts.is_alive() or tf.is_alive():
-            _render_panels(live_s, live_f)
-            time.sleep(0.2)
-
-        ts.join(); tf.join()
-        live_s["done"] = True
-        live_f["done"] = True
-        _render_panels(live_s, live_f)
-        ph_status.success("✓  Both algorithms finished.")
-        st.session_state.res_sewell = res_s[0]
-        st.session_state.res_furini = res_f[0]
-
-    def _run_one(solver_fn, key, live_label, color_cls, ph_active, ph_idle, idle_label):
-        live: dict = {}
-        ph_idle.markdown(race_panel_idle(idle_label), unsafe_allow_html=True)
-        res = [None]
-
-        def _t():
-            res[0] = solver_fn(gd, tmax, live)
+    def _render_panels(job):
+        for key, live in job["live"].items():
+            label, color_cls, side = _PANELS[key]
+            ph = ph_s if side == "s" else ph_f
+            ph.markdown(race_panel(label, color_cls, live), unsafe_allow_html=True)
+
+    def _watch(job):
+        """
+        Poll the live panels until every thread of job ends, then store
+        the results. Runs again on a rerun mid-solve (the Stop button, or
+        any other click), so an interrupted page never loses a solve.
+        """
+        if ph_stop.button("■  Stop", key="stop_run", use_container_width=True):
+            cancel(job["token"])
+            ph_status.warning("■  Stopping — keeping the best colourings found so far…")
+        else:
+            ph_status.info(job["status"])
+        for side, label in job["idle"]:
+            (ph_s if side == "s" else ph_f).markdown(race_panel_idle(label), unsafe_allow_html=True)
 
-        t = threading.Thread(target=_t, daemon=True)
-        t.start()
-        while t.is_alive():
-            ph_active.markdown(race_panel(live_label, color_cls, live), unsafe_allow_html=True)
+        while any(t.is_alive() for t in job["threads"]):
+            _render_panels(job)
             time.sleep(0.2)
-        t.join()
-        live["done"] = True
-        ph_active.markdown(race_panel(live_label, color_cls, live), unsafe_allow_html=True)
-        st.session_state[key] = res[0]
 
-    # ── Dispatch ──────────────────────────────────────────────────────
-    if run_both:
-        _run_both_parallel()
+        for t in job["threads"]:
+            t.join()
+        for live in job["live"].values():
+            live["done"] = True
+        _render_panels(job)
+        ph_stop.empty()
+        for key, res in job["res"].items():
+            st.session_state[key] = res
+        del st.session_state["run_job"]
         st.session_state.page = "results"
         st.rerun()
 
+    # ── Dispatch ──────────────────────────────────────────────────────
+    if st.session_state.get("run_job") is not None:
+        _watch(st.session_state.run_job)
+
+    elif run_both:
+        _watch(_start_job(gd, tmax, [("res_sewell", run_sewell), ("res_furini", run_furini)],
+                          "⟳  Both algorithms running in parallel (C engine)…"))
+
     elif run_s:
-        _run_one(solve_sewell, "res_sewell",
-                 "SEWELL (1996)", "race-s", ph_s, ph_f, "FURINI (2017)")
-        st.session_state.page = "results"
-        st.rerun()
+        _watch(_start_job(gd, tmax, [("res_sewell", run_sewell)],
+                          "⟳  Sewell running (C engine)…", idle=[("f", "FURINI (2017)")]))
 
     elif run_f:
-        _run_one(solve_furini, "res_furini",
-                 "FURINI (2017)", "race-f", ph_f, ph_s, "SEWELL (1996)")
-        st.session_state.page = "results"
-        st.rerun()
+        _watch(_start_job(gd, tmax, [("res_furini", run_furini)],
+                          "⟳  Furini running (C engine)…", idle=[("s", "SEWELL (1996)")]))
+
+    elif run_pf:
+        _watch(_start_job(gd, tmax, [("res_portfolio", solve_portfolio)],
+                          "⟳  Portfolio running (C engine)…", idle=[("f", "—")]))
 
     else:
         # Show existing results in panels if available
@@ -143,7 +176,7 @@ def render():
         else:
             ph_f.markdown(race_panel_idle("FURINI (2017)"), unsafe_allow_html=True)
 
-        if rs or rf:
+        if rs or rf or st.session_state.get("res_portfolio"):
             if st.button("View Results →", use_container_width=True):
                 st.session_state.page = "results"
                 st.rerun()
@@ -220,3 +220,77 @@ def fig_bar_compare(rs: dict, rf: dict, field: str, title: str) -> go.Figure:
         **_BASE,
     )
     return fig
+
+
+# ── Search instrumentation (res["stats"], BB_STATS builds) ────────────────
+
+_PHASE_LABELS = {"select": "Select", "bound": "Bound", "color": "Color",
+                 "uncolor": "Uncolor", "clock": "Clock"}
+
+
+def fig_phase_cycles(stats: dict, line_color: str) -> go.Figure:
+    phases = list(_PHASE_LABELS)
+    cyc    = [stats["cycles"][p] for p in phases]
+    calls  = [stats["appels"][p] for p in phases]
+    total  = sum(cyc) or 1
+    fig = go.Figure(go.Bar(
+        x=[_PHASE_LABELS[p] for p in phases], y=cyc, marker_color=line_color,
+        text=[f"{100 * c / total:.1f}%" for c in cyc], textposition="outside",
+        textfont=dict(size=9, color="#8892a4"),
+        customdata=[c // k if k else 0 for c, k in zip(cyc, calls)],
+        hovertemplate="%{x}: %{y:,} cycles<br>%{customdata:,} per call<extra></extra>",
+    ))
+    fig.update_layout(
+        showlegend=False, height=300,
+        margin=dict(l=50, r=20, t=20, b=40),
+        yaxis=dict(gridcolor="#1c2333", title="Cycles"),
+        **_BASE,
+    )
+    return fig
+
+
+def fig_depth_pruning(stats: dict, line_color: str) -> go.Figure | None:
+    rows = stats["par_profondeur"]
+    if not rows:
+        return None
+    df = pd.DataFrame(rows)
+    rate = [100 * c / t if t else None for c, t in zip(df["coupes"], df["tests"])]
+    fig = make_subplots(specs=[[{"secondary_y": True}]])
+    fig.add_trace(
+        go.Bar(x=df["profondeur"], y=df["noeuds"], name="Nodes",
+               marker_color="#4a5568"),
+        secondary_y=False,
+    )
+    fig.add_trace(
+        go.Scatter(x=df["profondeur"], y=rate, name="Pruned %",
+                   line=dict(color=line_color, width=2), connectgaps=False),
+        secondary_y=True,
+    )
+    fig.update_layout(
+        height=300, margin=dict(l=50, r=50, t=20, b=40),
+        legend=dict(bgcolor="#0d1117", bordercolor="#1c2333",
+                    borderwidth=1, font=dict(size=10)),
+        **_BASE,
+    )
+    fig.update_xaxes(title_text="Depth", gridcolor="#1c2333", title_font=dict(size=10))
+    fig.update_yaxes(title_text="Nodes",    gridcolor="#1c2333", title_font=dict(size=10), secondary_y=False)
+    fig.update_yaxes(title_text="Pruned %", gridcolor="#1c2333", title_font=dict(size=10),
+                     range=[0, 100], secondary_y=True)
+    return fig
+
+
+def fig_branching(stats: dict, line_color: str) -> go.Figure | None:
+    hist = stats["branchement"]
+    if not hist:
+        return None
+    fig = go.Figure(go.Bar(
+        x=list(range(len(hist))), y=hist, marker_color=line_color,
+    ))
+    fig.update_layout(
+        showlegend=False, height=300,
+        margin=dict(l=50, r=20, t=20, b=40),
+        xaxis=dict(gridcolor="#1c2333", title="Branches per node", dtick=1),
+        yaxis=dict(gridcolor="#1c2333", title="Branching nodes"),
+        **_BASE,
+    )
+    return fig
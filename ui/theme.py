@@ -85,6 +85,12 @@ p, li, .stMarkdown p { color:#555555 !important; }
     padding:.5rem .8rem; background:#f0fff4; border:1px solid #d6f5e8;
     border-radius:8px; margin-bottom:.8rem;
 }
+.algo-header-p {
+    font-family:'Inter',sans-serif; font-size:1rem; font-weight:700;
+    color:#cc7a00; display:flex; align-items:center; gap:.5rem;
+    padding:.5rem .8rem; background:#fff8ec; border:1px solid #f5e3c4;
+    border-radius:8px; margin-bottom:.8rem;
+}
 
 /* ── race card ── */
 .race-card {
@@ -96,6 +102,7 @@ p, li, .stMarkdown p { color:#555555 !important; }
 .race-label  { font-size:.68rem; color:#999999; text-transform:uppercase; letter-spacing:.08em; }
 .race-s { color:#0066cc; }
 .race-f { color:#009933; }
+.race-p { color:#cc7a00; }
 
 /* ── winner banner ── */
 .winner-banner {